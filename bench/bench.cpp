@@ -0,0 +1,180 @@
+/* Benchmark
+Times every engine over the families in graph_families.hpp and prints one JSON document to stdout.
+
+  karger_bench [--scale k] [--repetitions r] [--trials N] [--seed s]
+
+For each (graph, engine) pair the engine runs `repetitions` times (randomised engines with a fresh
+seed each time) and the result records
+- ns_per_edge: wall time per run divided by m
+- trials_per_second: runs per second (an N-trial run counts as N trials)
+- success_rate: fraction of runs that returned the known min cut (from the generator, or Stoer-Wagner)
+- peak_rss_kb: process peak resident set size after the runs (getrusage, so it only ever grows)
+Engines whose cost would swamp the run (bitmask, dense Stoer-Wagner, degree-biased) are skipped on
+graphs that are too large for them.
+*/
+
+#include "graph_families.hpp"
+#include "karger.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+namespace {
+
+struct Config {
+    int scale = 1;
+    int repetitions = 10;
+    int trials = 32; // N for the N-trial randomised engine
+    std::uint64_t seed = 1;
+};
+
+struct EngineSpec {
+    std::string name;
+    std::function<bool(const bench::Graph&)> applicable;
+    // returns the cut for repetition `rep`
+    std::function<int(const bench::Graph&, std::uint64_t rep)> run;
+    int trialsPerRun;
+};
+
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss; // kilobytes on Linux
+}
+
+std::vector<bench::Graph> families(const Config& config) {
+    int k = config.scale;
+    std::uint64_t seed = config.seed;
+    karger::GeneratorOptions options;
+    options.seed = seed;
+    return {
+        bench::gnp(64 * k, 0.1, seed),
+        bench::gnp(256 * k, 0.05, seed + 1),
+        bench::barbell(8 * k, 1),
+        bench::barbell(16 * k, 3),
+        bench::cycle(256 * k),
+        bench::grid(16 * k, 16 * k),
+        bench::powerLaw(512 * k, 3, seed + 2),
+        bench::planted(64 * k, 0.3, 4, seed + 3),
+        bench::generated("planted_clusters", "clusters=4,size=" + std::to_string(128 * k) + ",cycles=3,extra=4,bridges=2",
+                         karger::generatePlantedClusters(4, 128 * k, 3, 4, 2, options)),
+        bench::generated("random_regular", "n=" + std::to_string(1024 * k) + ",degree=6",
+                         karger::generateRandomRegular(1024 * k, 6, options)),
+        bench::generated("rmat", "scale=" + std::to_string(8 + k) + ",edge_factor=8,cycles=2,bridges=3",
+                         karger::generateRmat(8 + k, 8, 2, 3, options)),
+        bench::generated("torus", "rows=" + std::to_string(32 * k) + ",cols=" + std::to_string(32 * k),
+                         karger::generateGrid(32 * k, 32 * k, true, options)),
+    };
+}
+
+std::vector<EngineSpec> engines(const Config& config) {
+    auto always = [](const bench::Graph&) { return true; };
+    std::uint64_t seed = config.seed;
+    int trials = config.trials;
+    return {
+        {"randomised", always,
+         [seed](const bench::Graph& g, std::uint64_t rep) { return karger::minCutRandomised(g.n, g.edges, seed + rep); }, 1},
+        {"randomised_x" + std::to_string(trials), always,
+         [seed, trials](const bench::Graph& g, std::uint64_t rep) {
+             int best = 0;
+             for (int t = 0; t < trials; ++t) {
+                 int cut = karger::minCutRandomised(g.n, g.edges, seed + rep * trials + t);
+                 if (t == 0 || cut < best) best = cut;
+             }
+             return best;
+         }, trials},
+        {"randomised_parallel", always,
+         [seed](const bench::Graph& g, std::uint64_t rep) { return karger::minCutRandomisedParallel(g.n, g.edges, seed + rep); }, 1},
+        {"karger_stein", always,
+         [seed](const bench::Graph& g, std::uint64_t rep) { return karger::minCutKargerStein(g.n, g.edges, seed + rep); }, 1},
+        {"fixed_permutation", always,
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutFixedPermutation(g.n, g.edges); }, 1},
+        {"fixed_permutation_parallel", always,
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutFixedPermutationParallel(g.n, g.edges); }, 1},
+        {"degree_biased",
+         [](const bench::Graph& g) { return 1.0 * g.n * g.edges.size() * (g.n + g.edges.size()) <= 1e8; },
+         [](const bench::Graph& g, std::uint64_t) { return karger::deterministic_degree_biased_karger(g.n, g.edges); }, 1},
+        {"bitmask", [](const bench::Graph& g) { return g.n <= 20; },
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutBitmask(g.n, g.edges); }, 1},
+        {"stoer_wagner_dense", [](const bench::Graph& g) { return g.n <= 512; },
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutStoerWagnerDense(g.n, g.edges); }, 1},
+        {"stoer_wagner", always,
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutStoerWagner(g.n, g.edges); }, 1},
+        {"hao_orlin_sparsified", always,
+         [seed](const bench::Graph& g, std::uint64_t rep) {
+             return static_cast<int>(std::lround(karger::minCutSparsified(g.n, g.edges, 0.5, seed + rep)));
+         }, 1},
+        {"hao_orlin", always,
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutHaoOrlin(g.n, g.edges); }, 1},
+        {"matula", always,
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCutApproxMatula(g.n, g.edges, 0.5); }, 1},
+        {"dispatch_exact", always,
+         [](const bench::Graph& g, std::uint64_t) { return karger::minCut(g.n, g.edges); }, 1},
+    };
+}
+
+// family, engine and parameter names only ever need quotes and backslashes escaped
+std::string quoted(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--scale") config.scale = std::stoi(argv[i + 1]);
+        else if (arg == "--repetitions") config.repetitions = std::stoi(argv[i + 1]);
+        else if (arg == "--trials") config.trials = std::stoi(argv[i + 1]);
+        else if (arg == "--seed") config.seed = std::stoull(argv[i + 1]);
+        else {
+            std::cerr << "unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    std::cout << "{\"benchmark\": \"karger\", \"scale\": " << config.scale << ", \"repetitions\": " << config.repetitions
+              << ", \"seed\": " << config.seed << ", \"results\": [";
+
+    bool first = true;
+    for (const auto& g : families(config)) {
+        int reference = g.minCut >= 0 ? g.minCut : karger::minCutStoerWagner(g.n, g.edges);
+        for (const auto& engine : engines(config)) {
+            if (!engine.applicable(g)) continue;
+
+            int successes = 0;
+            auto start = Clock::now();
+            for (int rep = 0; rep < config.repetitions; ++rep) {
+                if (engine.run(g, rep) == reference) ++successes;
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            double runs = config.repetitions;
+            double m = g.edges.empty() ? 1.0 : static_cast<double>(g.edges.size());
+
+            char numbers[256];
+            std::snprintf(numbers, sizeof numbers,
+                          "\"seconds\": %.6f, \"ns_per_edge\": %.3f, \"trials_per_second\": %.3f, \"success_rate\": %.4f, "
+                          "\"peak_rss_kb\": %ld",
+                          seconds, seconds * 1e9 / (runs * m), runs * engine.trialsPerRun / seconds, successes / runs, peakRssKb());
+
+            std::cout << (first ? "\n" : ",\n") << "  {\"family\": " << quoted(g.family) << ", \"params\": " << quoted(g.params)
+                      << ", \"n\": " << g.n << ", \"m\": " << g.edges.size() << ", \"min_cut\": " << reference
+                      << ", \"engine\": " << quoted(engine.name) << ", " << numbers << "}";
+            first = false;
+        }
+    }
+    std::cout << "\n]}\n";
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef KARGER_BENCH_GRAPH_FAMILIES_HPP
+#define KARGER_BENCH_GRAPH_FAMILIES_HPP
+
+// Parameterised graph families for the benchmark. Every family is connected. Families built by the
+// library generators carry their known min cut, the benchmark takes the others from an exact engine.
+
+#include "karger.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct Graph {
+    std::string family;
+    std::string params;
+    int n = 0;
+    std::vector<karger::Edge> edges;
+    int minCut = -1; // -1 when unknown
+};
+
+inline Graph generated(const std::string& family, const std::string& params, karger::GeneratedGraph g) {
+    return {family, params, g.n, std::move(g.edges), g.minCut};
+}
+
+// Erdos-Renyi G(n, p) plus a Hamiltonian path so it is always connected
+inline Graph gnp(int n, double p, std::uint64_t seed) {
+    Graph g{"gnp", "n=" + std::to_string(n) + ",p=" + std::to_string(p), n, {}};
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution coin(p);
+    for (int i = 0; i + 1 < n; ++i) g.edges.push_back({i, i + 1});
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 2; j < n; ++j) {
+            if (coin(rng)) g.edges.push_back({i, j});
+        }
+    }
+    return g;
+}
+
+// two cliques K_s joined by k bridges, the "two triangles + bridge" tests generalised
+inline Graph barbell(int s, int k) {
+    Graph g{"barbell", "s=" + std::to_string(s) + ",k=" + std::to_string(k), 2 * s, {}};
+    for (int side = 0; side < 2; ++side) {
+        int base = side * s;
+        for (int i = 0; i < s; ++i) {
+            for (int j = i + 1; j < s; ++j) g.edges.push_back({base + i, base + j});
+        }
+    }
+    for (int b = 0; b < k; ++b) g.edges.push_back({b % s, s + (b * 7 + 3) % s});
+    return g;
+}
+
+// cycle C_n (min cut = 2)
+inline Graph cycle(int n) {
+    Graph g{"cycle", "n=" + std::to_string(n), n, {}};
+    for (int i = 0; i < n; ++i) g.edges.push_back({i, (i + 1) % n});
+    return g;
+}
+
+// rows x cols grid (min cut = 2, a corner)
+inline Graph grid(int rows, int cols) {
+    Graph g{"grid", "rows=" + std::to_string(rows) + ",cols=" + std::to_string(cols), rows * cols, {}};
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int v = r * cols + c;
+            if (c + 1 < cols) g.edges.push_back({v, v + 1});
+            if (r + 1 < rows) g.edges.push_back({v, v + cols});
+        }
+    }
+    return g;
+}
+
+// Barabasi-Albert preferential attachment, each new vertex brings `attach` edges
+inline Graph powerLaw(int n, int attach, std::uint64_t seed) {
+    Graph g{"power_law", "n=" + std::to_string(n) + ",attach=" + std::to_string(attach), n, {}};
+    std::mt19937_64 rng(seed);
+    // endpoints of every edge so far, sampling from it is sampling proportional to degree
+    std::vector<int> endpoints;
+    for (int i = 0; i <= attach && i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            g.edges.push_back({i, j});
+            endpoints.push_back(i);
+            endpoints.push_back(j);
+        }
+    }
+    for (int v = attach + 1; v < n; ++v) {
+        for (int k = 0; k < attach; ++k) {
+            std::uniform_int_distribution<std::size_t> pick(0, endpoints.size() - 1);
+            int u = endpoints[pick(rng)];
+            g.edges.push_back({v, u});
+            endpoints.push_back(v);
+            endpoints.push_back(u);
+        }
+    }
+    return g;
+}
+
+// two dense G(s, pIn) clusters with `cross` random edges between them
+inline Graph planted(int s, double pIn, int cross, std::uint64_t seed) {
+    Graph g{"planted", "s=" + std::to_string(s) + ",p_in=" + std::to_string(pIn) + ",cross=" + std::to_string(cross), 2 * s, {}};
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution coin(pIn);
+    for (int side = 0; side < 2; ++side) {
+        int base = side * s;
+        for (int i = 0; i + 1 < s; ++i) g.edges.push_back({base + i, base + i + 1});
+        for (int i = 0; i < s; ++i) {
+            for (int j = i + 2; j < s; ++j) {
+                if (coin(rng)) g.edges.push_back({base + i, base + j});
+            }
+        }
+    }
+    std::uniform_int_distribution<int> pick(0, s - 1);
+    for (int c = 0; c < cross; ++c) g.edges.push_back({pick(rng), s + pick(rng)});
+    return g;
+}
+
+}
+
+#endif
@@ -0,0 +1,183 @@
+/* Union-find micro-benchmark
+Runs the disjoint set access pattern of one Karger trial (unite edges in random order until two
+supernodes remain, then find both ends of every edge to count the cut) for every compression and
+linking policy of karger::UnionFind, plus the free findParent / unionSets functions with their O(n)
+reinitialisation as the baseline, and prints one JSON document to stdout.
+
+  union_find_bench [--scale k] [--trials t] [--seed s]
+
+Each combination runs `trials` trials per graph over the same precomputed edge orders, resetting between
+trials, and the result records
+- ns_per_op: wall time divided by the number of unite and find calls
+- trials_per_second
+- checksum: sum of the cuts found, identical for every combination on the same graph
+*/
+
+#include "graph_families.hpp"
+#include "karger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Config {
+    int scale = 1;
+    int trials = 200;
+    std::uint64_t seed = 1;
+};
+
+constexpr int kOrders = 8; // distinct edge orders, reused round robin so shuffling stays out of the timing
+
+struct Workload {
+    const bench::Graph* graph;
+    std::vector<std::vector<std::uint32_t>> orders;
+};
+
+struct Outcome {
+    double seconds = 0.0;
+    double ops = 0.0;
+    long long checksum = 0;
+};
+
+template <class UF>
+Outcome runPolicy(const Workload& w, int trials) {
+    const bench::Graph& g = *w.graph;
+    UF uf(g.n);
+    Outcome out;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < trials; ++t) {
+        for (std::uint32_t idx : w.orders[t % kOrders]) {
+            if (uf.components() <= 2) break;
+            uf.unite(g.edges[idx].u, g.edges[idx].v);
+            out.ops += 1;
+        }
+        int cut = 0;
+        for (const auto& e : g.edges) cut += uf.find(e.u) != uf.find(e.v);
+        out.ops += 2.0 * g.edges.size();
+        out.checksum += cut;
+        uf.reset();
+    }
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return out;
+}
+
+// the original free functions, reinitialised with an O(n) loop every trial
+Outcome runLegacy(const Workload& w, int trials) {
+    const bench::Graph& g = *w.graph;
+    std::vector<int> parent(g.n), rank(g.n);
+    Outcome out;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < trials; ++t) {
+        for (int i = 0; i < g.n; ++i) {
+            parent[i] = i;
+            rank[i] = 0;
+        }
+        int supernodes = g.n;
+        for (std::uint32_t idx : w.orders[t % kOrders]) {
+            if (supernodes <= 2) break;
+            if (karger::unionSets(parent, rank, g.edges[idx].u, g.edges[idx].v)) --supernodes;
+            out.ops += 1;
+        }
+        int cut = 0;
+        for (const auto& e : g.edges) cut += karger::findParent(parent, e.u) != karger::findParent(parent, e.v);
+        out.ops += 2.0 * g.edges.size();
+        out.checksum += cut;
+    }
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return out;
+}
+
+struct Policy {
+    std::string compression;
+    std::string linking;
+    Outcome (*run)(const Workload&, int);
+};
+
+template <class Compression, class Linking>
+Policy policy(const char* compression, const char* linking) {
+    return {compression, linking, &runPolicy<karger::UnionFind<int, Compression, Linking>>};
+}
+
+std::vector<Policy> policies() {
+    using namespace karger;
+    return {
+        {"legacy_halving", "legacy_rank", &runLegacy},
+        policy<PathHalving, LinkByRank>("halving", "rank"),
+        policy<PathHalving, LinkBySize>("halving", "size"),
+        policy<PathHalving, LinkByRandomPriority>("halving", "random"),
+        policy<PathSplitting, LinkByRank>("splitting", "rank"),
+        policy<PathSplitting, LinkBySize>("splitting", "size"),
+        policy<PathSplitting, LinkByRandomPriority>("splitting", "random"),
+        policy<FullCompression, LinkByRank>("full", "rank"),
+        policy<FullCompression, LinkBySize>("full", "size"),
+        policy<FullCompression, LinkByRandomPriority>("full", "random"),
+    };
+}
+
+std::vector<bench::Graph> families(const Config& config) {
+    int k = config.scale;
+    karger::GeneratorOptions options;
+    options.seed = config.seed;
+    return {
+        bench::gnp(256 * k, 0.05, config.seed),
+        bench::grid(64 * k, 64 * k),
+        bench::powerLaw(4096 * k, 3, config.seed + 1),
+        bench::generated("random_regular", "n=" + std::to_string(16384 * k) + ",degree=6",
+                         karger::generateRandomRegular(16384 * k, 6, options)),
+        bench::generated("rmat", "scale=" + std::to_string(12 + k) + ",edge_factor=8,cycles=2,bridges=3",
+                         karger::generateRmat(12 + k, 8, 2, 3, options)),
+    };
+}
+
+std::string quoted(const std::string& s) {
+    return "\"" + s + "\"";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--scale") config.scale = std::stoi(argv[i + 1]);
+        else if (arg == "--trials") config.trials = std::stoi(argv[i + 1]);
+        else if (arg == "--seed") config.seed = std::stoull(argv[i + 1]);
+        else {
+            std::cerr << "unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "{\"benchmark\": \"union_find\", \"scale\": " << config.scale << ", \"trials\": " << config.trials
+              << ", \"seed\": " << config.seed << ", \"results\": [";
+
+    bool first = true;
+    std::mt19937_64 rng(config.seed);
+    for (const auto& g : families(config)) {
+        Workload w{&g, {}};
+        for (int k = 0; k < kOrders; ++k) {
+            std::vector<std::uint32_t> order(g.edges.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::shuffle(order.begin(), order.end(), rng);
+            w.orders.push_back(std::move(order));
+        }
+
+        for (const auto& p : policies()) {
+            Outcome o = p.run(w, config.trials);
+            char numbers[160];
+            std::snprintf(numbers, sizeof numbers, "\"seconds\": %.6f, \"ns_per_op\": %.3f, \"trials_per_second\": %.3f, \"checksum\": %lld",
+                          o.seconds, o.seconds * 1e9 / o.ops, config.trials / o.seconds, o.checksum);
+            std::cout << (first ? "\n" : ",\n") << "  {\"family\": " << quoted(g.family) << ", \"params\": " << quoted(g.params)
+                      << ", \"n\": " << g.n << ", \"m\": " << g.edges.size() << ", \"compression\": " << quoted(p.compression)
+                      << ", \"linking\": " << quoted(p.linking) << ", " << numbers << "}";
+            first = false;
+        }
+    }
+    std::cout << "\n]}\n";
+    return 0;
+}
@@ -0,0 +1,317 @@
+/* Binary graph files
+A compact on-disk form of the edge list that can be memory-mapped and used in place, so repeated runs skip
+text parsing and every process mapping the same file shares one copy through the page cache.
+
+Layout (native byte order, every section starts on a 64-byte boundary):
+  header      magic "KRGRGRPH", version, byte order mark, n, m, index width (4 bytes), weight type,
+              byte offsets of the sections below (0 when a section is absent)
+  edges       m records laid out exactly like karger::Edge (two int32)
+  weights     m int32, only when weight type is Int32
+  degrees     n uint32, number of edge endpoints at each vertex (optional)
+  offsets     n + 1 uint64, CSR row starts into adjacency (optional, written together with adjacency)
+  adjacency   2m int32 neighbour ids, each edge listed from both ends (optional)
+
+Opening a file checks every section against the file size and every stored id against n in one pass over
+the mapping, so a truncated or corrupt file throws instead of reaching the engines.
+
+BinaryGraphStream writes the same layout without the optional sections when m is not known up front (a
+generator's sink): it reserves the header, appends edges as they arrive and fills the header in last.
+*/
+
+#include "karger.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace karger {
+
+namespace {
+
+constexpr char kMagic[8] = {'K', 'R', 'G', 'R', 'G', 'R', 'P', 'H'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kByteOrder = 0x01020304;
+constexpr std::uint64_t kAlign = 64;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t n;
+    std::uint64_t m;
+    std::uint32_t indexBytes;
+    std::uint32_t weightType;
+    std::uint64_t edgesOffset;
+    std::uint64_t weightsOffset;
+    std::uint64_t degreesOffset;
+    std::uint64_t offsetsOffset;
+    std::uint64_t adjacencyOffset;
+};
+static_assert(sizeof(Edge) == 2 * sizeof(std::int32_t), "binary graph files store Edge records as two int32");
+
+constexpr std::uint64_t alignUp(std::uint64_t x) {
+    return (x + kAlign - 1) / kAlign * kAlign;
+}
+
+std::runtime_error fileError(const std::string& what, const std::string& path) {
+    return std::runtime_error("binary graph: " + what + " " + path + ": " + std::strerror(errno));
+}
+
+class Writer {
+public:
+    Writer(const std::string& path) : path_(path), file_(std::fopen(path.c_str(), "wb")) {
+        if (!file_) throw fileError("cannot create", path);
+    }
+    ~Writer() {
+        if (file_) std::fclose(file_);
+    }
+
+    // pads with zeros up to `offset`, then writes `bytes`
+    void writeAt(std::uint64_t offset, const void* data, std::size_t bytes) {
+        static const char zeros[kAlign] = {};
+        while (position_ < offset) {
+            std::size_t pad = static_cast<std::size_t>(std::min<std::uint64_t>(kAlign, offset - position_));
+            put(zeros, pad);
+        }
+        put(data, bytes);
+    }
+
+    void close() {
+        int rc = std::fclose(file_);
+        file_ = nullptr;
+        if (rc != 0) throw fileError("cannot finish", path_);
+    }
+
+private:
+    void put(const void* data, std::size_t bytes) {
+        if (bytes != 0 && std::fwrite(data, 1, bytes, file_) != bytes) throw fileError("cannot write", path_);
+        position_ += bytes;
+    }
+
+    std::string path_;
+    std::FILE* file_;
+    std::uint64_t position_ = 0;
+};
+
+}
+
+void writeBinaryGraph(const std::string& path, int n, std::span<const Edge> edges, const BinaryGraphOptions& options) {
+    // the degree and CSR tables index by id, and a file with a stray id would only be rejected on open
+    if (n < 0) throw std::invalid_argument("writeBinaryGraph: negative vertex count");
+    for (const auto& e : edges) {
+        if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) throw std::invalid_argument("writeBinaryGraph: vertex id outside [0, n)");
+    }
+    const std::uint64_t m = edges.size();
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof kMagic);
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.n = static_cast<std::uint64_t>(n);
+    header.m = m;
+    header.indexBytes = sizeof(std::int32_t);
+    header.weightType = static_cast<std::uint32_t>(options.weights ? WeightType::Int32 : WeightType::None);
+
+    std::uint64_t at = alignUp(sizeof(Header));
+    header.edgesOffset = at;
+    at = alignUp(at + m * sizeof(Edge));
+    if (options.weights) {
+        header.weightsOffset = at;
+        at = alignUp(at + m * sizeof(std::int32_t));
+    }
+
+    std::vector<std::uint32_t> degree;
+    if (options.degrees || options.csr) {
+        degree.assign(n, 0);
+        for (const auto& e : edges) {
+            ++degree[e.u];
+            ++degree[e.v];
+        }
+    }
+    if (options.degrees) {
+        header.degreesOffset = at;
+        at = alignUp(at + static_cast<std::uint64_t>(n) * sizeof(std::uint32_t));
+    }
+
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::int32_t> adjacency;
+    if (options.csr) {
+        offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (int v = 0; v < n; ++v) offsets[v + 1] = offsets[v] + degree[v];
+        adjacency.resize(2 * m);
+        std::vector<std::uint64_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& e : edges) {
+            adjacency[fill[e.u]++] = e.v;
+            adjacency[fill[e.v]++] = e.u;
+        }
+        header.offsetsOffset = at;
+        at = alignUp(at + offsets.size() * sizeof(std::uint64_t));
+        header.adjacencyOffset = at;
+    }
+
+    Writer out(path);
+    out.writeAt(0, &header, sizeof header);
+    out.writeAt(header.edgesOffset, edges.data(), m * sizeof(Edge));
+    if (options.weights) out.writeAt(header.weightsOffset, options.weights, m * sizeof(std::int32_t));
+    if (options.degrees) out.writeAt(header.degreesOffset, degree.data(), degree.size() * sizeof(std::uint32_t));
+    if (options.csr) {
+        out.writeAt(header.offsetsOffset, offsets.data(), offsets.size() * sizeof(std::uint64_t));
+        out.writeAt(header.adjacencyOffset, adjacency.data(), adjacency.size() * sizeof(std::int32_t));
+    }
+    out.close();
+}
+
+BinaryGraphStream::BinaryGraphStream(const std::string& path) : path_(path), file_(std::fopen(path.c_str(), "wb")) {
+    if (!file_) throw fileError("cannot create", path);
+    // room for the header, written last, so the edges start at the offset writeBinaryGraph gives them
+    static const char zeros[alignUp(sizeof(Header))] = {};
+    if (std::fwrite(zeros, 1, sizeof zeros, file_) != sizeof zeros) throw fileError("cannot write", path_);
+}
+
+BinaryGraphStream::~BinaryGraphStream() {
+    if (file_) std::fclose(file_);
+}
+
+void BinaryGraphStream::write(const Edge* edges, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        lowest_ = std::min({lowest_, edges[i].u, edges[i].v});
+        highest_ = std::max({highest_, edges[i].u, edges[i].v});
+    }
+    if (count != 0 && std::fwrite(edges, sizeof(Edge), count, file_) != count) throw fileError("cannot write", path_);
+    m_ += count;
+}
+
+void BinaryGraphStream::finish(int n) {
+    if (lowest_ < 0 || highest_ >= n) throw std::invalid_argument("BinaryGraphStream: vertex id outside [0, n)");
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof kMagic);
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.n = static_cast<std::uint64_t>(n);
+    header.m = m_;
+    header.indexBytes = sizeof(std::int32_t);
+    header.weightType = static_cast<std::uint32_t>(WeightType::None);
+    header.edgesOffset = alignUp(sizeof(Header));
+    if (std::fseek(file_, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof header, 1, file_) != 1) {
+        throw fileError("cannot write", path_);
+    }
+    int rc = std::fclose(file_);
+    file_ = nullptr;
+    if (rc != 0) throw fileError("cannot finish", path_);
+}
+
+void convertEdgeListToBinary(const std::string& textPath, const std::string& binaryPath, const BinaryGraphOptions& options, int threads) {
+    EdgeList input = readEdgeList(textPath, threads);
+    writeBinaryGraph(binaryPath, input.n, input.edges, options);
+}
+
+bool isBinaryGraph(const std::string& path) {
+    char magic[sizeof kMagic] = {};
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    bool match = std::fread(magic, 1, sizeof magic, file) == sizeof magic && std::memcmp(magic, kMagic, sizeof kMagic) == 0;
+    std::fclose(file);
+    return match;
+}
+
+MappedGraph::MappedGraph(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw fileError("cannot open", path);
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        throw std::runtime_error("binary graph: " + path + " is too short to hold a header");
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    // shared read-only mapping, every process on the machine reuses the same page cache pages
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) throw fileError("cannot map", path);
+    base_ = static_cast<const char*>(addr);
+
+    Header header;
+    std::memcpy(&header, base_, sizeof header);
+    auto fail = [&](const std::string& why) {
+        munmap(const_cast<char*>(base_), size_);
+        base_ = nullptr;
+        throw std::runtime_error("binary graph: " + path + ": " + why);
+    };
+    if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0) fail("not a binary graph file");
+    if (header.version != kVersion) fail("unsupported version " + std::to_string(header.version));
+    if (header.byteOrder != kByteOrder) fail("written on a machine with a different byte order");
+    if (header.indexBytes != sizeof(std::int32_t)) fail("unsupported index width");
+    if (header.n > static_cast<std::uint64_t>(INT32_MAX)) fail("too many vertices");
+
+    // every section must lie inside the file; counts are compared with the room left before anything is
+    // multiplied, so a corrupt count can not wrap around
+    auto section = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t width) -> const char* {
+        if (offset == 0) return nullptr;
+        if (offset % kAlign != 0 || offset > size_ || count > (size_ - offset) / width) fail("truncated or corrupt section table");
+        return base_ + offset;
+    };
+    n_ = static_cast<int>(header.n);
+    m_ = static_cast<std::size_t>(header.m);
+    edges_ = reinterpret_cast<const Edge*>(section(header.edgesOffset, header.m, sizeof(Edge)));
+    if (!edges_ && m_ != 0) fail("missing edge section");
+    if (header.weightType == static_cast<std::uint32_t>(WeightType::Int32)) {
+        weights_ = reinterpret_cast<const std::int32_t*>(section(header.weightsOffset, header.m, sizeof(std::int32_t)));
+        if (!weights_ && m_ != 0) fail("missing weight section");
+    } else if (header.weightType != static_cast<std::uint32_t>(WeightType::None)) {
+        fail("unknown weight type");
+    }
+    degrees_ = reinterpret_cast<const std::uint32_t*>(section(header.degreesOffset, header.n, sizeof(std::uint32_t)));
+    offsets_ = reinterpret_cast<const std::uint64_t*>(section(header.offsetsOffset, header.n + 1, sizeof(std::uint64_t)));
+    adjacency_ = reinterpret_cast<const std::int32_t*>(section(header.adjacencyOffset, header.m, 2 * sizeof(std::int32_t)));
+    if ((offsets_ == nullptr) != (adjacency_ == nullptr)) fail("CSR offsets and adjacency must come together");
+
+    // the engines index by these ids unchecked, so one O(n + m) pass makes sure they stay inside [0, n)
+    auto outside = [this](std::int32_t v) { return v < 0 || v >= n_; };
+    std::vector<std::uint32_t> degree(degrees_ ? n_ : 0, 0);
+    for (std::size_t i = 0; i < m_; ++i) {
+        if (outside(edges_[i].u) || outside(edges_[i].v)) fail("edge " + std::to_string(i) + " has an endpoint outside [0, n)");
+        if (degrees_) {
+            ++degree[edges_[i].u];
+            ++degree[edges_[i].v];
+        }
+    }
+    if (degrees_ && !std::equal(degree.begin(), degree.end(), degrees_)) fail("degree table does not match the edges");
+    if (offsets_) {
+        if (offsets_[0] != 0 || offsets_[n_] != 2 * header.m) fail("CSR offsets do not span the adjacency");
+        for (int v = 0; v < n_; ++v) {
+            if (offsets_[v] > offsets_[v + 1]) fail("CSR offsets are not ascending");
+        }
+        for (std::uint64_t i = 0; i < 2 * header.m; ++i) {
+            if (outside(adjacency_[i])) fail("CSR adjacency holds an id outside [0, n)");
+        }
+    }
+}
+
+MappedGraph::MappedGraph(MappedGraph&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedGraph& MappedGraph::operator=(MappedGraph&& other) noexcept {
+    if (this != &other) {
+        if (base_) munmap(const_cast<char*>(base_), size_);
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        n_ = other.n_;
+        m_ = other.m_;
+        edges_ = other.edges_;
+        weights_ = other.weights_;
+        degrees_ = other.degrees_;
+        offsets_ = other.offsets_;
+        adjacency_ = other.adjacency_;
+    }
+    return *this;
+}
+
+MappedGraph::~MappedGraph() {
+    if (base_) munmap(const_cast<char*>(base_), size_);
+}
+
+}
@@ -26,21 +26,18 @@ removing self-loops
 cut size
 */
 
-#include <iostream>
-#include <vector>
+#include "karger.hpp"
 #include <unordered_map>
 #include <unordered_set>
-#include <algorithm>
-#include <tuple>
 #include <queue>
-#include <string>
-#include <climits>
 
-using namespace std;
+namespace karger {
+
+namespace {
 
 // Graph representation: adjacency list with multiplicities
 // adj[u][v] = number of edges between u and v
-using Graph = vector<unordered_map<int, int>>;
+using Graph = std::vector<std::unordered_map<int, int>>;
 
 //Compute degree of a vertex (sum of all edge multiplicities)
 int compute_degree(const Graph& adj, int u) {
@@ -55,7 +52,7 @@ int compute_degree(const Graph& adj, int u) {
 Contract edge (u,v): merge v into u
 Precondition: u < v
  */
-void contract_edge(Graph& adj, vector<bool>& active, int u, int v) {
+void contract_edge(Graph& adj, std::vector<bool>& active, int u, int v) {
     // Merge all of v's neighbors into u
     for (const auto& [w, mult] : adj[v]) {
         if (w == u) continue; // Skip self-loop
@@ -76,11 +73,11 @@ void contract_edge(Graph& adj, vector<bool>& active, int u, int v) {
     adj[u].erase(u);
 }
 
-bool is_cut_edge(const Graph& adj, int u, int v, const vector<bool>& active) {
+bool is_cut_edge(const Graph& adj, int u, int v, const std::vector<bool>& active) {
     // Do BFS/DFS from u without using edge to v
     // If we can't reach v, the edge is a cut edge
-    unordered_set<int> visited;
-    queue<int> q;
+    std::unordered_set<int> visited;
+    std::queue<int> q;
     q.push(u);
     visited.insert(u);
     
@@ -106,13 +103,15 @@ bool is_cut_edge(const Graph& adj, int u, int v, const vector<bool>& active) {
     return true;
 }
 
+}
+
 //Time: O(n·m), Space: O(n+m)
-int deterministic_degree_biased_karger(int n, const vector<pair<int,int>>& edges) {
+int deterministic_degree_biased_karger(int n, std::span<const Edge> edges) {
     if (n <= 1) return 0;
     
     // Build adjacency list with multiplicities
     Graph adj(n);
-    for (const auto& [u, v] : edges) {
+    for (const auto& [u, v] : detail::intEdges(edges)) {
         if (u != v) { // Ignore self-loops in input
             adj[u][v]++;
             adj[v][u]++;
@@ -120,7 +119,7 @@ int deterministic_degree_biased_karger(int n, const vector<pair<int,int>>& edges
     }
     
     // Track active supernodes
-    vector<bool> active(n, true);
+    std::vector<bool> active(n, true);
     int num_active = n;
     
     // Contract until two supernodes remain
@@ -146,7 +145,7 @@ int deterministic_degree_biased_karger(int n, const vector<pair<int,int>>& edges
                 }
                 
                 // Lexicographic comparison: (score, u, v)
-                if (score > best_score || (score == best_score && make_pair(u, v) < make_pair(best_u, best_v))) {
+                if (score > best_score || (score == best_score && std::make_pair(u, v) < std::make_pair(best_u, best_v))) {
                     best_score = score;
                     best_u = u;
                     best_v = v;
@@ -167,7 +166,7 @@ int deterministic_degree_biased_karger(int n, const vector<pair<int,int>>& edges
     // Find the two remaining supernodes and compute cut value
     if (num_active < 2) return 0;
     
-    vector<int> remaining;
+    std::vector<int> remaining;
     for (int i = 0; i < n; i++) {
         if (active[i]) remaining.push_back(i);
     }
@@ -180,84 +179,11 @@ int deterministic_degree_biased_karger(int n, const vector<pair<int,int>>& edges
     return 0;
 }
 
-void run_cli() {
-    int n, m;
-    cin >> n >> m;
-    
-    vector<pair<int,int>> edges;
-    for (int i = 0; i < m; i++) {
-        int u, v;
-        cin >> u >> v;
-        edges.push_back({u, v});
-    }
-    
-    int result = deterministic_degree_biased_karger(n, edges);
-    cout << result << endl;
+int deterministic_degree_biased_karger(int n, const std::vector<std::pair<int,int>>& edges) {
+    std::vector<Edge> converted;
+    converted.reserve(edges.size());
+    for (const auto& [u, v] : edges) converted.push_back({u, v});
+    return deterministic_degree_biased_karger(n, converted);
 }
 
-//Unit tests
-void run_tests() {
-    cout << "Running tests\n" << endl;
-    
-    struct TestCase {
-        string name;
-        int n;
-        vector<pair<int,int>> edges;
-        int expected;
-    };
-    
-    vector<TestCase> tests = {
-        {"Two triangles with bridge", 6,{{0,1},{1,2},{2,0},{3,4},{4,5},{5,3},{2,3}}, 1},
-        {"Square with diagonal", 4, {{0,1},{1,2},{2,3},{3,0},{0,2}}, 2},
-        {"Triangle", 3, {{0,1},{1,2},{0,2}}, 2},
-        {"Parallel edges (multiplicity 3)", 2, {{0,1},{0,1},{0,1}}, 3},
-        {"Disconnected graph", 3, {}, 0},
-        {"Barbell - single bridge", 6, {{0,1},{1,2},{2,0}, {3,4},{4,5},{5,3}, {2,3}}, 1},
-        {"Barbell - double bridge", 6, {{0,1},{1,2},{2,0}, {3,4},{4,5},{5,3}, {2,3},{2,3}}, 2},
-        {"Lollipop - K3 + path", 5, {{0,1},{1,2},{2,0}, {2,3},{3,4}}, 1},
-        {"Graph with isolated vertices", 5, {{0,1},{1,2},{2,0}}, 0},
-        {"C4 with one diagonal", 4, {{0,1},{1,2},{2,3},{3,0}, {1,3}}, 2},
-        {"C5 with one chord", 5, {{0,1},{1,2},{2,3},{3,4},{4,0}, {0,2}}, 2},
-        {"C6 with symmetric chords", 6, {{0,1},{1,2},{2,3},{3,4},{4,5},{5,0}, {0,3},{1,4}}, 2},
-        {"Complete K4", 4, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}}, 3},
-        {"Complete K5", 5, {{0,1},{0,2},{0,3},{0,4},{1,2},{1,3},{1,4},{2,3},{2,4},{3,4}},4},
-        {"Triangle with asymmetric multiplicities", 3, {{0,1},{0,1},{0,1}, {1,2}, {2,0}}, 2},
-        {"Dual-path bottleneck", 8, {{0,1},{1,0}, {2,3},{3,2},  {0,4},{4,5},{5,2}, {1,6},{6,7},{7,3}}, 2},
-        {"K4 with pendant via 2 edges", 5, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}, {3,4},{3,4}}, 2},
-        {"Weighted star graph", 5, {{0,1},{0,1}, {0,2},{0,2},{0,2}, {0,3}, {0,4}}, 1},
-        {"K5 minus one edge", 5, {{0,1},{0,2},{0,3},{0,4},{1,2},{1,3},{1,4},{2,3},{2,4}}, 3},
-        {"Bowtie (two triangles, shared vertex)", 5, {{0,1},{1,2},{2,0}, {2,3},{3,4},{4,2}}, 2}
-    };
-    
-    bool all_passed = true;
-    int failcount = 0;
-
-    for (const auto& test : tests) {
-        int result = deterministic_degree_biased_karger(test.n, test.edges);
-        bool passed = (result == test.expected);
-        all_passed = all_passed && passed;
-        
-        cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << endl;
-        cout << "  Expected: " << test.expected << ", Got: " << result << endl;
-        if (!passed){
-            failcount++;
-        }
-    }
-    
-    cout << string(50, '-') << endl;
-    if (all_passed) {
-        cout << "All tests PASSED" << endl;
-    } else {
-        cout << std::to_string(failcount) + " tests FAILED" << endl;
-    }
 }
-
-int main(int argc, char* argv[]) {
-    if (argc > 1 && string(argv[1]) == "--test") {
-        run_tests();
-    } else {
-        run_cli();
-    }
-    
-    return 0;
-}
\ No newline at end of file
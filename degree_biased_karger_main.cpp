@@ -0,0 +1,90 @@
+/* Jared S
+Command line driver and unit tests for the degree-biased contraction engine (degree_biased_karger.cpp).
+Reads "n m" followed by m edge pairs from stdin (karger::readEdgeList), or runs the test table with --test.
+*/
+
+#include "karger.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+int run_cli() {
+    karger::EdgeList input;
+    try {
+        input = karger::readEdgeList(0); // stdin
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    int result = karger::deterministic_degree_biased_karger(input.n, input.edges);
+    cout << result << endl;
+    return 0;
+}
+
+//Unit tests
+bool run_tests() {
+    cout << "Running tests\n" << endl;
+    
+    struct TestCase {
+        string name;
+        int n;
+        vector<karger::Edge> edges;
+        int expected;
+    };
+    
+    vector<TestCase> tests = {
+        {"Two triangles with bridge", 6,{{0,1},{1,2},{2,0},{3,4},{4,5},{5,3},{2,3}}, 1},
+        {"Square with diagonal", 4, {{0,1},{1,2},{2,3},{3,0},{0,2}}, 2},
+        {"Triangle", 3, {{0,1},{1,2},{0,2}}, 2},
+        {"Parallel edges (multiplicity 3)", 2, {{0,1},{0,1},{0,1}}, 3},
+        {"Disconnected graph", 3, {}, 0},
+        {"Barbell - single bridge", 6, {{0,1},{1,2},{2,0}, {3,4},{4,5},{5,3}, {2,3}}, 1},
+        {"Barbell - double bridge", 6, {{0,1},{1,2},{2,0}, {3,4},{4,5},{5,3}, {2,3},{2,3}}, 2},
+        {"Lollipop - K3 + path", 5, {{0,1},{1,2},{2,0}, {2,3},{3,4}}, 1},
+        {"Graph with isolated vertices", 5, {{0,1},{1,2},{2,0}}, 0},
+        {"C4 with one diagonal", 4, {{0,1},{1,2},{2,3},{3,0}, {1,3}}, 2},
+        {"C5 with one chord", 5, {{0,1},{1,2},{2,3},{3,4},{4,0}, {0,2}}, 2},
+        {"C6 with symmetric chords", 6, {{0,1},{1,2},{2,3},{3,4},{4,5},{5,0}, {0,3},{1,4}}, 2},
+        {"Complete K4", 4, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}}, 3},
+        {"Complete K5", 5, {{0,1},{0,2},{0,3},{0,4},{1,2},{1,3},{1,4},{2,3},{2,4},{3,4}},4},
+        {"Triangle with asymmetric multiplicities", 3, {{0,1},{0,1},{0,1}, {1,2}, {2,0}}, 2},
+        {"Dual-path bottleneck", 8, {{0,1},{1,0}, {2,3},{3,2},  {0,4},{4,5},{5,2}, {1,6},{6,7},{7,3}}, 2},
+        {"K4 with pendant via 2 edges", 5, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}, {3,4},{3,4}}, 2},
+        {"Weighted star graph", 5, {{0,1},{0,1}, {0,2},{0,2},{0,2}, {0,3}, {0,4}}, 1},
+        {"K5 minus one edge", 5, {{0,1},{0,2},{0,3},{0,4},{1,2},{1,3},{1,4},{2,3},{2,4}}, 3},
+        {"Bowtie (two triangles, shared vertex)", 5, {{0,1},{1,2},{2,0}, {2,3},{3,4},{4,2}}, 2}
+    };
+    
+    bool all_passed = true;
+    int failcount = 0;
+
+    for (const auto& test : tests) {
+        int result = karger::deterministic_degree_biased_karger(test.n, test.edges);
+        bool passed = (result == test.expected);
+        all_passed = all_passed && passed;
+        
+        cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << endl;
+        cout << "  Expected: " << test.expected << ", Got: " << result << endl;
+        if (!passed){
+            failcount++;
+        }
+    }
+    
+    cout << string(50, '-') << endl;
+    if (all_passed) {
+        cout << "All tests PASSED" << endl;
+    } else {
+        cout << std::to_string(failcount) + " tests FAILED" << endl;
+    }
+    return all_passed;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--test") {
+        return run_tests() ? 0 : 1;
+    }
+    return run_cli();
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+/* Contraction dendrogram
+Every contraction run is a sequence of merges, and replaying that sequence once answers questions about
+every level at the same time.
+
+- The merges are replayed into a union-find with union by rank and no path compression, each link stamped
+  with its merge index. The supernode of v after s merges is the last ancestor of v reached through links
+  stamped below s, and union by rank keeps that walk O(log n).
+- The merges also form a binary merge tree (vertices as leaves, one node per merge). Listing the leaves in
+  tree order puts every supernode of every level in one contiguous range, so members() is a span.
+- Two vertices joined at the largest stamp on the path between them, found by always stepping up from
+  the endpoint with the smaller stamp. Counting edges by that stamp gives the crossing edges of every
+  level as a running difference.
+*/
+
+#include "karger.hpp"
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+template <class Index>
+constexpr Index kNever = std::numeric_limits<Index>::max(); // linkedAt_ of a vertex that stays a root
+
+}
+
+template <class Index>
+BasicDendrogram<Index>::BasicDendrogram(Index n, std::span<const BasicEdge<Index>> edges, std::vector<Merge> merges)
+    : n_(n), merges_(std::move(merges)) {
+    const Index steps = static_cast<Index>(merges_.size());
+    parent_.resize(n);
+    std::iota(parent_.begin(), parent_.end(), Index{0});
+    linkedAt_.assign(n, kNever<Index>);
+
+    // replay: survivor of each merge, and the merge tree children (node ids: vertices, then n + step)
+    std::vector<std::uint8_t> rank(n, 0);
+    std::vector<Index> node(n), survivor(steps), left(steps), right(steps);
+    std::iota(node.begin(), node.end(), Index{0});
+    auto root = [this](Index x) {
+        while (parent_[x] != x) x = parent_[x];
+        return x;
+    };
+    for (Index i = 0; i < steps; ++i) {
+        Index a = root(merges_[i].a), b = root(merges_[i].b);
+        if (a == b) throw std::invalid_argument("dendrogram merge joins a supernode with itself");
+        if (rank[a] < rank[b] || (rank[a] == rank[b] && a > b)) std::swap(a, b);
+        if (rank[a] == rank[b]) ++rank[a];
+        parent_[b] = a;
+        linkedAt_[b] = i;
+        survivor[i] = a;
+        left[i] = node[a];
+        right[i] = node[b];
+        node[a] = n + i;
+    }
+
+    // the merges each vertex survived as root, in step order
+    survivorBegin_.assign(static_cast<std::size_t>(n) + 1, 0);
+    for (Index a : survivor) ++survivorBegin_[a + 1];
+    std::partial_sum(survivorBegin_.begin(), survivorBegin_.end(), survivorBegin_.begin());
+    survivorSteps_.resize(steps);
+    std::vector<Index> fill(survivorBegin_.begin(), survivorBegin_.end() - 1);
+    for (Index i = 0; i < steps; ++i) survivorSteps_[fill[survivor[i]]++] = i;
+
+    // merge tree sizes bottom up, then ranges top down: the final supernodes in vertex order, each
+    // node's left child first
+    rangeSize_.assign(static_cast<std::size_t>(n) + steps, 1);
+    rangeBegin_.assign(static_cast<std::size_t>(n) + steps, 0);
+    for (Index i = 0; i < steps; ++i) rangeSize_[n + i] = rangeSize_[left[i]] + rangeSize_[right[i]];
+    Index next = 0;
+    for (Index v = 0; v < n; ++v) {
+        if (parent_[v] != v) continue;
+        rangeBegin_[node[v]] = next;
+        next += rangeSize_[node[v]];
+    }
+    for (Index i = steps; i-- > 0;) {
+        rangeBegin_[left[i]] = rangeBegin_[n + i];
+        rangeBegin_[right[i]] = rangeBegin_[n + i] + rangeSize_[left[i]];
+    }
+    order_.resize(n);
+    for (Index v = 0; v < n; ++v) order_[rangeBegin_[v]] = v;
+
+    // crossing_[s] = non-loop edges minus those whose endpoints met within the first s merges
+    std::vector<Index> metAt(static_cast<std::size_t>(steps) + 1, 0);
+    Index nonLoop = 0;
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        ++nonLoop;
+        Index u = e.u, v = e.v, met = 0;
+        while (u != v) {
+            if (linkedAt_[u] > linkedAt_[v]) std::swap(u, v);
+            if (linkedAt_[u] == kNever<Index>) { // both roots, never joined
+                met = steps;
+                break;
+            }
+            met = linkedAt_[u];
+            u = parent_[u];
+        }
+        ++metAt[met];
+    }
+    crossing_.resize(static_cast<std::size_t>(steps) + 1);
+    crossing_[0] = nonLoop;
+    for (Index s = 0; s < steps; ++s) crossing_[s + 1] = crossing_[s] - metAt[s];
+}
+
+template <class Index>
+Index BasicDendrogram<Index>::steps(Index k) const {
+    return n_ - std::clamp(k, minSupernodes(), n_);
+}
+
+template <class Index>
+Index BasicDendrogram<Index>::supernode(Index v, Index k) const {
+    Index s = steps(k);
+    while (linkedAt_[v] < s) v = parent_[v];
+    return v;
+}
+
+template <class Index>
+std::span<const Index> BasicDendrogram<Index>::members(Index v, Index k) const {
+    Index s = steps(k);
+    Index r = supernode(v, k);
+    // the last merge r survived before level k is its merge tree node, r itself when there is none
+    auto first = survivorSteps_.begin() + survivorBegin_[r];
+    auto last = std::lower_bound(first, survivorSteps_.begin() + survivorBegin_[r + 1], s);
+    std::size_t treeNode = (last == first) ? static_cast<std::size_t>(r) : static_cast<std::size_t>(n_ + last[-1]);
+    return {order_.data() + rangeBegin_[treeNode], static_cast<std::size_t>(rangeSize_[treeNode])};
+}
+
+template <class Index>
+Index BasicDendrogram<Index>::cutAt(Index k) const {
+    return crossing_[steps(k)];
+}
+
+template class BasicDendrogram<int>;
+template class BasicDendrogram<std::int64_t>;
+
+}
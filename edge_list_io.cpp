@@ -0,0 +1,278 @@
+/* Edge list input
+Reads the "n m, then m pairs" text format used by the command line drivers.
+
+The whole input is mapped (regular files) or slurped with large read() calls (pipes), then parsed into an
+edge vector sized from the m header. Lines starting with '#' or '%' (SNAP and Matrix Market banners) are
+comments, wherever they appear; a comment may also follow the last token of a line after whitespace. The
+header goes through std::from_chars; the body uses a plain digit loop that also range-checks each id
+against n as it goes, which measured faster than from_chars followed by a separate check. Large inputs
+are cut into chunks at whitespace boundaries; every chunk first counts its tokens, the counts are
+prefix-summed, and then every chunk parses straight into the edges at its offset, so nothing but the edge
+vector grows with the input. A single chunk skips the count and parses in place directly. Chunk
+boundaries sit just after a newline, so no number and no comment is ever split between chunks.
+
+The sparse variant reads "m" followed by m pairs of unsigned 64-bit ids through the same body parser,
+for graphs whose ids still have to go through remapVertexIds.
+*/
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace karger {
+
+namespace {
+
+constexpr std::size_t kMinChunkBytes = std::size_t{1} << 20;
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+inline bool isComment(char c) {
+    return c == '#' || c == '%';
+}
+
+// skips whitespace and comments up to the next token
+const char* skipSpace(const char* p, const char* end) {
+    while (p < end) {
+        if (isSpace(*p)) ++p;
+        else if (isComment(*p)) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            p = newline ? newline : end;
+        } else {
+            break;
+        }
+    }
+    return p;
+}
+
+template <class T>
+const char* parseNumber(const char* p, const char* end, T& value, const char* what) {
+    p = skipSpace(p, end);
+    auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc() || next == p || (next < end && !isSpace(*next))) {
+        throw std::runtime_error(std::string("edge list: could not read ") + what);
+    }
+    return next;
+}
+
+// calls emit(id) for every id in [p, end), false on a malformed token or an id out of range:
+// int ids must lie in [0, limit), 64-bit ids may take any value that fits
+template <class Id, class Emit>
+bool parseIds(const char* p, const char* end, std::uint64_t limit, Emit&& emit) {
+    constexpr std::uint64_t kMax = UINT64_MAX;
+    for (;;) {
+        p = skipSpace(p, end);
+        if (p == end) return true;
+        const char* start = p;
+        std::uint64_t value = 0;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+            unsigned digit = static_cast<unsigned>(*p - '0');
+            if constexpr (std::is_same_v<Id, int>) {
+                value = value * 10 + digit;
+                if (value >= limit) return false;
+            } else {
+                if (value > kMax / 10 || (value == kMax / 10 && digit > kMax % 10)) return false;
+                value = value * 10 + digit;
+            }
+            ++p;
+        }
+        if (p == start || (p < end && !isSpace(*p))) return false;
+        if (!emit(static_cast<Id>(value))) return false;
+    }
+}
+
+// tokens in [p, end), well-formed or not. Text without comments, the usual case, takes a branch-free loop
+// over neighbouring bytes that the compiler vectorises.
+std::size_t countIds(const char* p, const char* end) {
+    std::size_t bytes = static_cast<std::size_t>(end - p);
+    if (!std::memchr(p, '#', bytes) && !std::memchr(p, '%', bytes)) {
+        auto space = [](char c) { return c == ' ' || static_cast<unsigned char>(c - '\t') < 5; }; // \t \n \v \f \r
+        std::size_t count = bytes > 0 && !space(p[0]);
+        for (std::size_t i = 1; i < bytes; ++i) count += space(p[i - 1]) & !space(p[i]);
+        return count;
+    }
+    std::size_t count = 0;
+    for (p = skipSpace(p, end); p < end; p = skipSpace(p, end)) {
+        ++count;
+        while (p < end && !isSpace(*p)) ++p;
+    }
+    return count;
+}
+
+template <class EdgeT, class Id>
+void store(std::vector<EdgeT>& edges, std::size_t g, Id id) {
+    EdgeT& e = edges[g / 2];
+    if (g % 2 == 0) e.u = id;
+    else e.v = id;
+}
+
+struct Mapping {
+    const char* data = nullptr;
+    std::size_t size = 0;
+    bool mapped = false;
+    std::vector<char> buffer;
+
+    ~Mapping() {
+        if (mapped) munmap(const_cast<char*>(data), size);
+    }
+};
+
+// maps regular files, reads everything else (pipes, terminals) in large blocks
+void load(int fd, Mapping& input) {
+    struct stat info {};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* addr = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            madvise(addr, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+            input.data = static_cast<const char*>(addr);
+            input.size = static_cast<std::size_t>(info.st_size);
+            input.mapped = true;
+            return;
+        }
+    }
+
+    const std::size_t block = std::size_t{1} << 20;
+    std::size_t used = 0;
+    for (;;) {
+        input.buffer.resize(used + block);
+        ssize_t got = read(fd, input.buffer.data() + used, block);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("edge list: read failed: ") + std::strerror(errno));
+        }
+        if (got == 0) break;
+        used += static_cast<std::size_t>(got);
+    }
+    input.buffer.resize(used);
+    input.data = input.buffer.data();
+    input.size = used;
+}
+
+// parses the m edges after the header into `edges`, ids checked as in parseIds
+template <class Id, class EdgeT>
+void parseBody(const char* body, const char* end, long long m, std::uint64_t limit, int threads, std::vector<EdgeT>& edges) {
+    const std::size_t ids = 2 * static_cast<std::size_t>(m);
+    auto wrongCount = [m](std::size_t found) {
+        return std::runtime_error("edge list: header promises " + std::to_string(m) + " edges but the body holds " +
+                                  (found > 2 * static_cast<std::size_t>(m) ? "more" : std::to_string(found)) + " integers");
+    };
+    const char* badId = std::is_same_v<Id, int> ? "edge list: malformed edge or vertex id outside [0, n)"
+                                                : "edge list: malformed edge or vertex id above 2^64 - 1";
+
+    // every id takes at least two bytes with its separator, so a bogus header can not make us allocate
+    std::size_t bytes = static_cast<std::size_t>(end - body);
+    if (ids > bytes) throw wrongCount(countIds(body, end));
+    edges.resize(static_cast<std::size_t>(m));
+
+    std::size_t chunks = std::min<std::size_t>(detail::resolveThreads(threads), bytes / kMinChunkBytes + 1);
+    if (chunks == 1) {
+        std::size_t g = 0;
+        bool ok = parseIds<Id>(body, end, limit, [&](Id id) {
+            if (g == ids) return false;
+            store(edges, g++, id);
+            return true;
+        });
+        if (!ok && g == ids) throw wrongCount(g + 1);
+        if (!ok) throw std::runtime_error(badId);
+        if (g != ids) throw wrongCount(g);
+        return;
+    }
+
+    // chunk boundaries sit just past a newline so no token or comment is split
+    std::vector<const char*> bounds(chunks + 1, end);
+    bounds[0] = body;
+    for (std::size_t k = 1; k < chunks; ++k) {
+        const char* p = std::max(bounds[k - 1], body + bytes * k / chunks);
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        bounds[k] = newline ? newline + 1 : end;
+    }
+
+    // count, then parse every chunk in place at its offset
+    std::vector<std::size_t> offset(chunks + 1, 0);
+    detail::parallelFor(chunks, threads, [&](std::size_t k) { offset[k + 1] = countIds(bounds[k], bounds[k + 1]); });
+    for (std::size_t k = 0; k < chunks; ++k) offset[k + 1] += offset[k];
+    if (offset[chunks] != ids) throw wrongCount(offset[chunks]);
+
+    std::vector<char> ok(chunks, 0);
+    detail::parallelFor(chunks, threads, [&](std::size_t k) {
+        std::size_t g = offset[k];
+        ok[k] = parseIds<Id>(bounds[k], bounds[k + 1], limit, [&](Id id) {
+            if (g == offset[k + 1]) return false;
+            store(edges, g++, id);
+            return true;
+        });
+    });
+    for (char good : ok) {
+        if (!good) throw std::runtime_error(badId);
+    }
+}
+
+// opens `path`, hands the descriptor to read(fd) and closes it again
+template <class Read>
+auto readPath(const std::string& path, Read&& read) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("edge list: cannot open " + path + ": " + std::strerror(errno));
+    try {
+        auto out = read(fd);
+        close(fd);
+        return out;
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+}
+
+}
+
+EdgeList parseEdgeList(const char* data, std::size_t size, int threads) {
+    const char* end = data + size;
+    EdgeList out;
+    long long m = 0;
+    const char* body = parseNumber(data, end, out.n, "n");
+    body = parseNumber(body, end, m, "m");
+    if (out.n < 0 || m < 0) throw std::runtime_error("edge list: n and m must not be negative");
+    parseBody<int>(body, end, m, static_cast<std::uint64_t>(out.n), threads, out.edges);
+    return out;
+}
+
+std::vector<ExternalEdge> parseSparseEdgeList(const char* data, std::size_t size, int threads) {
+    const char* end = data + size;
+    std::vector<ExternalEdge> out;
+    long long m = 0;
+    const char* body = parseNumber(data, end, m, "m");
+    if (m < 0) throw std::runtime_error("edge list: m must not be negative");
+    parseBody<std::uint64_t>(body, end, m, UINT64_MAX, threads, out);
+    return out;
+}
+
+EdgeList readEdgeList(int fd, int threads) {
+    Mapping input;
+    load(fd, input);
+    return parseEdgeList(input.data, input.size, threads);
+}
+
+EdgeList readEdgeList(const std::string& path, int threads) {
+    return readPath(path, [threads](int fd) { return readEdgeList(fd, threads); });
+}
+
+std::vector<ExternalEdge> readSparseEdgeList(int fd, int threads) {
+    Mapping input;
+    load(fd, input);
+    return parseSparseEdgeList(input.data, input.size, threads);
+}
+
+std::vector<ExternalEdge> readSparseEdgeList(const std::string& path, int threads) {
+    return readPath(path, [threads](int fd) { return readSparseEdgeList(fd, threads); });
+}
+
+}
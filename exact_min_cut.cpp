@@ -0,0 +1,298 @@
+/* Exact engines
+These are used by the dispatcher (min_cut.cpp) whenever the caller asks for an exact answer, or when an
+exact answer is cheaper than running enough randomised trials.
+
+- minCutBitmask: enumerates every bipartition in Gray-code order so each step only moves one vertex,
+  O(2^(n-1) * n). Only sensible for tiny graphs.
+- minCutStoerWagnerDense: classic Stoer-Wagner on an n x n weight matrix, O(n^3) time and O(n^2) memory.
+- minCutStoerWagner: Stoer-Wagner over collapsed (weighted) adjacency lists with a lazy max-heap.
+  Supernodes are tracked with the same UnionFind as the Karger engines, O(n * m log m). An overload
+  takes a non-negative double weight per edge instead, for sparsified graphs, and
+  minCutStoerWagnerPartition also returns the sides.
+
+Each engine is a template over the index type (int or std::int64_t, see BasicEdge), which is also the
+type of the weights and the cut it returns.
+*/
+
+#include "karger.hpp"
+#include "pair_weights.hpp"
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+template <class Index>
+Index bitmask(Index n, std::span<const BasicEdge<Index>> edges) {
+    if (n <= 1) return 0;
+    if (n > 30) return -1; // the mask would overflow, callers should pick another engine
+
+    // weight[u * n + v] = multiplicity of (u, v), self-loops dropped
+    std::vector<Index> weight(static_cast<std::size_t>(n) * n, 0);
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        ++weight[static_cast<std::size_t>(e.u) * n + e.v];
+        ++weight[static_cast<std::size_t>(e.v) * n + e.u];
+    }
+
+    // vertex 0 stays on side A, bit v of sideB says whether v has moved to side B
+    std::uint32_t sideB = 0;
+    Index cut = 0;
+    Index best = std::numeric_limits<Index>::max();
+    const std::uint32_t limit = 1u << (n - 1);
+    for (std::uint32_t k = 1; k < limit; ++k) {
+        // the Gray code flips the bit of the lowest set bit of k, offset past vertex 0
+        int v = 1;
+        while (!((k >> (v - 1)) & 1u)) ++v;
+
+        const Index* row = &weight[static_cast<std::size_t>(v) * n];
+        Index toA = 0, toB = 0;
+        for (int u = 0; u < n; ++u) {
+            if (u == v) continue;
+            if ((sideB >> u) & 1u) toB += row[u];
+            else toA += row[u];
+        }
+
+        if ((sideB >> v) & 1u) cut += toB - toA; // v moves back to A
+        else cut += toA - toB; // v moves across to B
+        sideB ^= 1u << v;
+
+        if (cut < best) best = cut;
+    }
+    return best;
+}
+
+template <class Index>
+Index stoerWagnerDense(Index n, std::span<const BasicEdge<Index>> edges) {
+    if (n <= 1) return 0;
+
+    std::vector<Index> weight(static_cast<std::size_t>(n) * n, 0);
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        ++weight[static_cast<std::size_t>(e.u) * n + e.v];
+        ++weight[static_cast<std::size_t>(e.v) * n + e.u];
+    }
+
+    // vertices[0..remaining) are the live supernodes
+    std::vector<Index> vertices(n);
+    for (Index i = 0; i < n; ++i) vertices[i] = i;
+
+    std::vector<Index> key(n);
+    std::vector<char> added(n);
+    Index best = std::numeric_limits<Index>::max();
+
+    for (Index remaining = n; remaining > 1; --remaining) {
+        // one maximum-adjacency phase
+        std::fill(added.begin(), added.end(), 0);
+        for (Index i = 0; i < remaining; ++i) key[vertices[i]] = 0;
+
+        Index prev = -1, last = -1;
+        for (Index step = 0; step < remaining; ++step) {
+            Index pick = -1;
+            for (Index i = 0; i < remaining; ++i) {
+                Index v = vertices[i];
+                if (!added[v] && (pick == -1 || key[v] > key[pick])) pick = v;
+            }
+            added[pick] = 1;
+            prev = last;
+            last = pick;
+
+            const Index* row = &weight[static_cast<std::size_t>(pick) * n];
+            for (Index i = 0; i < remaining; ++i) {
+                Index v = vertices[i];
+                if (!added[v]) key[v] += row[v];
+            }
+        }
+
+        // cut of the phase separates `last` from everything else
+        if (key[last] < best) best = key[last];
+
+        // merge last into prev
+        for (Index i = 0; i < remaining; ++i) {
+            Index v = vertices[i];
+            weight[static_cast<std::size_t>(prev) * n + v] += weight[static_cast<std::size_t>(last) * n + v];
+            weight[static_cast<std::size_t>(v) * n + prev] = weight[static_cast<std::size_t>(prev) * n + v];
+        }
+        weight[static_cast<std::size_t>(prev) * n + prev] = 0;
+        for (Index i = 0; i < remaining; ++i) {
+            if (vertices[i] == last) {
+                vertices[i] = vertices[remaining - 1];
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+// phases over weighted adjacency lists; Weight is long long for edge counts, double for weighted edges.
+// `side`, when given, receives the vertices of the last supernode of the best phase.
+template <class Index, class Weight>
+Weight stoerWagnerPhases(Index n, const std::vector<std::vector<std::pair<Index, Weight>>>& adj,
+                         std::vector<Index>* side = nullptr) {
+    // supernodes: disjoint set for lookups, member lists to walk their original adjacency
+    UnionFind<Index> uf(n);
+    std::vector<std::vector<Index>> members(n);
+    std::vector<Index> live(n);
+    for (Index i = 0; i < n; ++i) {
+        members[i].push_back(i);
+        live[i] = i;
+    }
+
+    std::vector<Weight> key(n, 0);
+    std::vector<char> added(n, 0);
+    std::priority_queue<std::pair<Weight, Index>> heap;
+    Weight best = std::numeric_limits<Weight>::max();
+
+    for (Index remaining = n; remaining > 1; --remaining) {
+        for (Index i = 0; i < remaining; ++i) {
+            key[live[i]] = 0;
+            added[live[i]] = 0;
+        }
+        heap = {};
+
+        Index prev = -1, last = -1;
+        Index start = live[0];
+        heap.push({0, start});
+        for (Index step = 0; step < remaining; ++step) {
+            Index pick = -1;
+            while (!heap.empty()) {
+                auto [k, v] = heap.top();
+                heap.pop();
+                if (!added[v] && k == key[v]) {
+                    pick = v;
+                    break;
+                }
+            }
+            // disconnected remainder, restart from any supernode not yet added
+            if (pick == -1) {
+                for (Index i = 0; i < remaining; ++i) {
+                    if (!added[live[i]]) {
+                        pick = live[i];
+                        break;
+                    }
+                }
+            }
+            added[pick] = 1;
+            prev = last;
+            last = pick;
+
+            for (Index x : members[pick]) {
+                for (const auto& [y, w] : adj[x]) {
+                    Index r = uf.find(y);
+                    if (added[r]) continue;
+                    key[r] += w;
+                    heap.push({key[r], r});
+                }
+            }
+        }
+
+        if (key[last] < best) {
+            best = key[last];
+            if (side) *side = members[last];
+        }
+
+        // merge last into prev, keeping the larger member list as the survivor
+        uf.unite(prev, last);
+        Index root = uf.find(prev);
+        Index gone = (root == prev) ? last : prev;
+        if (members[root].size() < members[gone].size()) members[root].swap(members[gone]);
+        members[root].insert(members[root].end(), members[gone].begin(), members[gone].end());
+        members[gone].clear();
+        for (Index i = 0; i < remaining; ++i) {
+            if (live[i] == gone) {
+                live[i] = live[remaining - 1];
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+template <class Index>
+Index stoerWagner(Index n, std::span<const BasicEdge<Index>> edges, std::vector<Index>* side = nullptr) {
+    if (n <= 1) return 0;
+
+    // collapse parallel edges into weights so heavy multigraphs cost their distinct pairs only
+    std::vector<std::vector<std::pair<Index, long long>>> adj(n);
+    for (const auto& [a, b, w] : detail::collapseParallelEdges<long long>(edges)) {
+        adj[a].push_back({b, w});
+        adj[b].push_back({a, w});
+    }
+    return static_cast<Index>(stoerWagnerPhases(n, adj, side));
+}
+
+// the cut as a 2-partition, part 0 holding vertex 0
+template <class Index>
+BasicKCut<Index> stoerWagnerPartition(Index n, std::span<const BasicEdge<Index>> edges) {
+    BasicKCut<Index> out;
+    out.part.assign(std::max<Index>(n, 0), 0);
+    if (n <= 1) return out;
+    std::vector<Index> side;
+    out.value = stoerWagner(n, edges, &side);
+    for (Index v : side) out.part[v] = 1;
+    if (out.part[0] == 1) {
+        for (Index& p : out.part) p = 1 - p;
+    }
+    return out;
+}
+
+template <class Index>
+double stoerWagnerWeighted(Index n, std::span<const BasicEdge<Index>> edges, std::span<const double> weights) {
+    if (edges.size() != weights.size()) throw std::invalid_argument("minCutStoerWagner needs one weight per edge");
+    if (n <= 1) return 0.0;
+
+    std::vector<std::vector<std::pair<Index, double>>> adj(n);
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (weights[i] < 0.0) throw std::invalid_argument("minCutStoerWagner needs non-negative weights");
+        if (edges[i].u == edges[i].v) continue;
+        adj[edges[i].u].push_back({edges[i].v, weights[i]});
+        adj[edges[i].v].push_back({edges[i].u, weights[i]});
+    }
+    return stoerWagnerPhases(n, adj);
+}
+
+}
+
+int minCutBitmask(int n, std::span<const Edge> edges) {
+    return bitmask(n, detail::intEdges(edges));
+}
+
+std::int64_t minCutBitmask(std::int64_t n, std::span<const Edge64> edges) {
+    return bitmask(n, edges);
+}
+
+int minCutStoerWagnerDense(int n, std::span<const Edge> edges) {
+    return stoerWagnerDense(n, detail::intEdges(edges));
+}
+
+std::int64_t minCutStoerWagnerDense(std::int64_t n, std::span<const Edge64> edges) {
+    return stoerWagnerDense(n, edges);
+}
+
+int minCutStoerWagner(int n, std::span<const Edge> edges) {
+    return stoerWagner(n, detail::intEdges(edges));
+}
+
+std::int64_t minCutStoerWagner(std::int64_t n, std::span<const Edge64> edges) {
+    return stoerWagner(n, edges);
+}
+
+KCut minCutStoerWagnerPartition(int n, std::span<const Edge> edges) {
+    return stoerWagnerPartition(n, detail::intEdges(edges));
+}
+
+KCut64 minCutStoerWagnerPartition(std::int64_t n, std::span<const Edge64> edges) {
+    return stoerWagnerPartition(n, edges);
+}
+
+double minCutStoerWagner(int n, std::span<const Edge> edges, std::span<const double> weights) {
+    return stoerWagnerWeighted(n, detail::intEdges(edges), weights);
+}
+
+double minCutStoerWagner(std::int64_t n, std::span<const Edge64> edges, std::span<const double> weights) {
+    return stoerWagnerWeighted(n, edges, weights);
+}
+
+}
@@ -1,4 +1,5 @@
 #include "karger.hpp"
+#include <algorithm>
 /* Dom C
 I have chosen to implement the Deterministic Karger – Fixed Permutation algorithm.
 
@@ -19,127 +20,148 @@ My thought process for the implementation is as follows:
 */
 
 namespace karger {
-int minCutFixedPermutation(int n, const std::vector<Edge>& edges) {
-        if (n <= 1) return 0; // no cut possible
-        if (edges.empty()) return 0; // no edges, no cut
 
-        // Step 1 - create disjoint set for all vertices
-        std::vector<int> parent(n);
-        std::vector<int> rank(n, 0);
-        for (int i = 0; i < n; ++i) parent[i] = i; // each vertex is its own parent initially
-
-        // Step 2 - create a fixed (input-derived) perumutation, and sort edges by (min(u,v), max(u,v)) to remove randomness
-        std::vector<Edge> sortedEdges = edges;
-        std::sort(sortedEdges.begin(), sortedEdges.end(), [](const Edge& a, const Edge& b) {
-            int au = std::min(a.u, a.v);
-            int av = std::max(a.u, a.v);
-            int bu = std::min(b.u, b.v);
-            int bv = std::max(b.u, b.v);
-            if (au == bu) return av < bv;
-            return au < bu;
-        });
-
-        // Step 3 - contract edges following the fixed order
-        int vertices = n;
-        for (const Edge& edge : sortedEdges) {
-            if (vertices <= 2) break; // stop when only two supernodes remain
-            int a = findParent(parent, edge.u);
-            int b = findParent(parent, edge.v);
-            if (a != b) {
-                unionSets(parent, rank, a, b);
-                vertices--;
-            }
+namespace {
+
+// one edge with its endpoints in sort order, so comparing two edges is a pair comparison
+template <class Index>
+struct SortedPair {
+    Index lo, hi;
+    bool operator<(const SortedPair& o) const { return lo < o.lo || (lo == o.lo && hi < o.hi); }
+    bool operator==(const SortedPair& o) const { return lo == o.lo && hi == o.hi; }
+};
+
+constexpr std::ptrdiff_t kSortCutoff = 512; // partitions this small are sorted and scanned directly
+
+template <class Index, class Obs>
+struct Contraction {
+    UnionFind<Index>& uf;
+    Index& vertices;
+    Obs& observer;
+
+    bool done() const { return vertices <= 2; } // stop when only two supernodes remain
+
+    void contract(const SortedPair<Index>& edge) {
+        Index a = uf.find(edge.lo);
+        Index b = uf.find(edge.hi);
+        if (a != b) {
+            uf.unite(a, b);
+            vertices--;
+            observer.onContraction(a, b, vertices);
         }
+    }
 
-        // Step 4 - determine which supernodes remain
-        std::vector<int> supernodes;
-        for (int i = 0; i < n; ++i) {
-            int p = findParent(parent, i);
-            if (std::find(supernodes.begin(), supernodes.end(), p) == supernodes.end()) {
-                supernodes.push_back(p);
+    // Filter-Kruskal: contract the light side of a pivot first, then drop the heavy edges that the light
+    // side already closed before partitioning what is left. Every edge is contracted in the same order a
+    // full sort would give, but edges past the stopping point are never sorted, and edges inside one
+    // supernode are only filtered.
+    void run(SortedPair<Index>* first, SortedPair<Index>* last) {
+        while (!done() && first != last) {
+            if (last - first <= kSortCutoff) {
+                std::sort(first, last);
+                for (auto* e = first; e != last && !done(); ++e) contract(*e);
+                return;
             }
+
+            // median of three, then < pivot | == pivot | > pivot
+            SortedPair<Index> a = first[0], b = first[(last - first) / 2], c = last[-1];
+            SortedPair<Index> pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+            auto* equal = std::partition(first, last, [&](const SortedPair<Index>& e) { return e < pivot; });
+            auto* heavy = std::partition(equal, last, [&](const SortedPair<Index>& e) { return e == pivot; });
+
+            run(first, equal);
+            if (done()) return;
+            contract(pivot); // the rest of the equal run are parallel copies, self-loops by now
+
+            last = std::remove_if(heavy, last, [&](const SortedPair<Index>& e) {
+                return uf.same(e.lo, e.hi);
+            });
+            first = heavy;
+        }
+    }
+};
+
+// shared by every overload, with NullObserver every hook inlines away; Index is int or std::int64_t
+template <class Index, class Obs>
+Index fixedPermutationTrial(Index n, std::span<const BasicEdge<Index>> edges, Obs& observer) {
+        if (n <= 1 || edges.empty()) { // no cut possible
+            observer.onTrialComplete(0, 0);
+            observer.onResult(0);
+            return 0;
         }
 
-        if (supernodes.size() < 2) return 0; // no cut possible
+        // Step 1 - create disjoint set for all vertices
+        UnionFind<Index> uf(n); // each vertex is its own set initially
 
-        int supernodeA = supernodes[0];
-        int supernodeB = supernodes[1];
+        // Step 2 - create a fixed (input-derived) perumutation: edges ordered by (min(u,v), max(u,v)) to remove randomness
+        std::vector<SortedPair<Index>> order;
+        order.reserve(edges.size());
+        for (const auto& e : edges) {
+            if (e.u != e.v) order.push_back({std::min(e.u, e.v), std::max(e.u, e.v)});
+        }
+
+        // Step 3 - contract edges following the fixed order, sorting only as much of it as the contraction reaches
+        Index vertices = n;
+        Contraction<Index, Obs> contraction{uf, vertices, observer};
+        contraction.run(order.data(), order.data() + order.size());
+
+        // Step 4 - the first two distinct supernodes in vertex order
+        Index supernodeA = -1, supernodeB = -1;
+        for (Index i = 0; i < n; ++i) {
+            Index p = uf.find(i);
+            if (supernodeA == -1) supernodeA = p;
+            else if (p != supernodeA) { supernodeB = p; break; }
+        }
+
+        if (supernodeB == -1) { // no cut possible
+            observer.onTrialComplete(0, 0);
+            observer.onResult(0);
+            return 0;
+        }
 
         // Step 5 - count crossing edges between the two remaining supernodes
-        int cutSize = 0;
+        Index cutSize = 0;
         for (const auto& e : edges) {
-            int a = findParent(parent, e.u);
-            int b = findParent(parent, e.v);
+            Index a = uf.find(e.u);
+            Index b = uf.find(e.v);
             if (a == supernodeA && b == supernodeB) cutSize++;
             else if (a == supernodeB && b == supernodeA) cutSize++;
         }
 
-        std::cout << "Final cut size (deterministic Karger - fixed permutation): " << cutSize << "\n";
+        observer.onTrialComplete(0, cutSize);
+        observer.onResult(cutSize);
         return cutSize;
     }
+
 }
 
-int main() {
-    std::cout << "Dom C - Deterministic Karger (Fixed Permutation) Tests\n";
-
-    struct TestCase {
-        std::string name;
-        int n;
-        std::vector<karger::Edge> edges;
-    };
-
-    std::vector<TestCase> domCTests = {
-        // Small / hand-checkable
-        {"simple 4-node (K4 minus 0-3)", 4, {{0,1},{0,2},{1,2},{1,3},{2,3}}}, // global min cut = 2
-        {"triangle", 3, {{0,1},{1,2},{0,2}}}, // global min cut = 2
-        {"path length 3", 4, {{0,1},{1,2},{2,3}}}, // global min cut = 1
-        {"square cycle", 4, {{0,1},{1,2},{2,3},{3,0}}}, // global min cut = 2
-        {"star graph", 5, {{0,1},{0,2},{0,3},{0,4}}}, // global min cut = 1
-
-        // Cliques
-        {"complete K4", 4, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}}}, // global min cut = 3
-        {"complete K5", 5, {
-            {0,1},{0,2},{0,3},{0,4},
-            {1,2},{1,3},{1,4},
-            {2,3},{2,4},
-            {3,4}
-        }}, // global min cut = 4
-
-        // Bipartite / structured
-        {"complete bipartite K2,3", 5, {
-            {0,2},{0,3},{0,4},
-            {1,2},{1,3},{1,4}
-        }}, // global min cut = 2
-        {"cycle with chord (C4 + diagonal 0-2)", 4, {{0,1},{1,2},{2,3},{3,0},{0,2}}}, // global min cut = 2
-
-        // Bridges & multi-edges
-        {"two triangles + single bridge", 6, {
-            {0,1},{1,2},{0,2}, // left triangle
-            {3,4},{4,5},{3,5}, // right triangle
-            {2,3} // single bridge (global min cut = 1)
-        }},
-        {"two triangles + double bridge (parallel edges)", 6, {
-            {0,1},{1,2},{0,2},
-            {3,4},{4,5},{3,5},
-            {2,3},{2,3} // two parallel bridges (global min cut = 2)
-        }},
-
-        // Parallel edges inside a component
-        {"square + parallel edge", 4, {{0,1},{1,2},{2,3},{3,0},{0,1}}}, // still expect a small cut (>=2)
-
-        // Self-loops (should be ignored by logic)
-        {"triangle + self-loop", 3, {{0,1},{1,2},{0,2},{1,1}}}, // self-loop should not affect cut
-
-        // Disconnected / sparse
-        {"disconnected (one edge only)", 5, {{0,1}}}, // global min cut = 0
-        {"empty graph", 4, {}}, // global min cut = 0
-    };
-
-    for (const auto& test : domCTests) {
-        std::cout << "test: " << test.name << "\n";
-        int cut = karger::minCutFixedPermutation(test.n, test.edges);
-        std::cout << "cut = " << cut << "\n";
-    }
+int minCutFixedPermutation(int n, std::span<const Edge> edges) {
+    NullObserver observer;
+    return fixedPermutationTrial(n, detail::intEdges(edges), observer);
+}
 
-    return 0;
+int minCutFixedPermutation(int n, std::span<const Edge> edges, Observer& observer) {
+    return fixedPermutationTrial(n, detail::intEdges(edges), observer);
+}
+
+std::int64_t minCutFixedPermutation(std::int64_t n, std::span<const Edge64> edges) {
+    NullObserver observer;
+    return fixedPermutationTrial(n, edges, observer);
+}
+
+std::int64_t minCutFixedPermutation(std::int64_t n, std::span<const Edge64> edges, Observer& observer) {
+    return fixedPermutationTrial(n, edges, observer);
+}
+
+Dendrogram contractionDendrogramFixedPermutation(int n, std::span<const Edge> edges) {
+    MergeRecorder<int> recorder;
+    fixedPermutationTrial(n, detail::intEdges(edges), recorder);
+    return Dendrogram(n, edges, std::move(recorder.merges));
+}
+
+Dendrogram64 contractionDendrogramFixedPermutation(std::int64_t n, std::span<const Edge64> edges) {
+    MergeRecorder<std::int64_t> recorder;
+    fixedPermutationTrial(n, edges, recorder);
+    return Dendrogram64(n, edges, std::move(recorder.merges));
+}
 }
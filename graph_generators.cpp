@@ -0,0 +1,281 @@
+/* Graph generators
+Synthetic families whose min cut is known by construction, so engines can be checked and benchmarked far
+beyond the hand-written test tables.
+
+The building block is a random Hamiltonian cycle: any cut that splits its vertex set crosses it at least
+twice. A cluster made of `cycles` such cycles (weights w_i) therefore has internal edge connectivity at
+least 2 * sum(w_i) >= 2 * cycles, whatever else is added inside it. Joining clusters along a path with
+`bridges` unit edges per boundary, with bridges <= 2 * cycles, makes the bridge set the min cut.
+
+- generatePlantedClusters: clusters of Hamiltonian cycles plus uniform random internal edges.
+- generateRandomRegular: one cluster of degree / 2 cycles, a 2 * sum(w_i)-regular multigraph whose
+  min cut is exactly its degree.
+- generateRmat: two RMAT (power-law) halves, each over a Hamiltonian cycle backbone, joined by bridges.
+- generateGrid: rows x cols grid or torus, min cut 2 (a corner) or 4 (any vertex), times the weight.
+
+Work is split into segments (one cycle, or a block of random edges), each with its own RNG derived from
+options.seed and the segment index. Segments are generated in parallel batches and handed to the sink in
+order, so the output is identical for any thread count and only one batch is held in memory.
+*/
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+constexpr std::size_t kBlockEdges = std::size_t{1} << 16;
+
+struct Segment {
+    std::size_t count; // edges written by fill, before weighting
+    std::function<void(std::mt19937_64& rng, Edge* out)> fill;
+    int weight; // every edge of the segment gets this weight, 0 = draw one per edge
+};
+
+// deterministic weight in [1, maxWeight] for a given key
+int drawWeight(const GeneratorOptions& options, std::uint64_t key) {
+    if (options.maxWeight <= 1) return 1;
+    return 1 + static_cast<int>(detail::mix64(options.seed ^ detail::mix64(key)) % static_cast<std::uint64_t>(options.maxWeight));
+}
+
+// random Hamiltonian cycle over [base, base + size)
+Segment hamiltonianCycle(int base, int size, int weight) {
+    return {static_cast<std::size_t>(size), [base, size](std::mt19937_64& rng, Edge* out) {
+        std::vector<int> perm(size);
+        for (int i = 0; i < size; ++i) perm[i] = base + i;
+        std::shuffle(perm.begin(), perm.end(), rng);
+        for (int i = 0; i < size; ++i) out[i] = {perm[i], perm[(i + 1) % size]};
+    }, weight};
+}
+
+// `count` uniform random edges inside [base, base + size), split into blocks, no self-loops
+void uniformEdges(std::vector<Segment>& segments, int base, int size, std::size_t count) {
+    for (std::size_t done = 0; done < count; done += kBlockEdges) {
+        std::size_t block = std::min(kBlockEdges, count - done);
+        segments.push_back({block, [base, size, block](std::mt19937_64& rng, Edge* out) {
+            std::uniform_int_distribution<int> pick(base, base + size - 1);
+            for (std::size_t i = 0; i < block; ++i) {
+                int u = pick(rng), v = pick(rng);
+                while (v == u) v = pick(rng);
+                out[i] = {u, v};
+            }
+        }, 0});
+    }
+}
+
+// `count` unit edges between [baseA, baseA + size) and [baseB, baseB + size)
+Segment bridgeEdges(int baseA, int baseB, int size, int count) {
+    return {static_cast<std::size_t>(count), [baseA, baseB, size, count](std::mt19937_64& rng, Edge* out) {
+        std::uniform_int_distribution<int> pick(0, size - 1);
+        for (int i = 0; i < count; ++i) out[i] = {baseA + pick(rng), baseB + pick(rng)};
+    }, 1};
+}
+
+// RMAT edges over [base, base + 2^scale) with the Graph500 quadrant probabilities, no self-loops
+void rmatEdges(std::vector<Segment>& segments, int base, int scale, std::size_t count) {
+    for (std::size_t done = 0; done < count; done += kBlockEdges) {
+        std::size_t block = std::min(kBlockEdges, count - done);
+        segments.push_back({block, [base, scale, block](std::mt19937_64& rng, Edge* out) {
+            const double a = 0.57, b = 0.19, c = 0.19;
+            std::uniform_real_distribution<double> coin(0.0, 1.0);
+            for (std::size_t i = 0; i < block; ++i) {
+                int u, v;
+                do {
+                    u = 0;
+                    v = 0;
+                    for (int bit = 0; bit < scale; ++bit) {
+                        double r = coin(rng);
+                        if (r < a) continue;
+                        if (r < a + b) v |= 1 << bit;
+                        else if (r < a + b + c) u |= 1 << bit;
+                        else {
+                            u |= 1 << bit;
+                            v |= 1 << bit;
+                        }
+                    }
+                } while (u == v);
+                out[i] = {base + u, base + v};
+            }
+        }, 0});
+    }
+}
+
+// generate every segment and stream it to the sink (or into graph.edges when there is no sink)
+void emit(const std::vector<Segment>& segments, const GeneratorOptions& options, const EdgeSink& sink, GeneratedGraph& graph) {
+    int threads = detail::resolveThreads(options.threads);
+    std::vector<std::vector<Edge>> buffers(threads);
+    std::vector<Edge> expanded;
+
+    auto deliver = [&](const Edge* edges, std::size_t count) {
+        graph.m += count;
+        if (sink) sink(edges, count);
+        else graph.edges.insert(graph.edges.end(), edges, edges + count);
+    };
+
+    if (!sink && options.maxWeight <= 1) {
+        std::size_t total = 0;
+        for (const auto& segment : segments) total += segment.count;
+        graph.edges.reserve(total);
+    }
+
+    for (std::size_t start = 0; start < segments.size(); start += threads) {
+        std::size_t batch = std::min<std::size_t>(threads, segments.size() - start);
+        detail::parallelFor(batch, threads, [&](std::size_t k) {
+            const Segment& segment = segments[start + k];
+            std::mt19937_64 rng(detail::mix64(options.seed ^ detail::mix64(start + k)));
+            buffers[k].resize(segment.count);
+            segment.fill(rng, buffers[k].data());
+        });
+
+        for (std::size_t k = 0; k < batch; ++k) {
+            const Segment& segment = segments[start + k];
+            const std::vector<Edge>& edges = buffers[k];
+            if (segment.weight == 1 || (segment.weight == 0 && options.maxWeight <= 1)) {
+                deliver(edges.data(), edges.size());
+                continue;
+            }
+
+            // weight w becomes w consecutive copies of the edge
+            expanded.clear();
+            std::uint64_t key = detail::mix64(~static_cast<std::uint64_t>(start + k));
+            for (std::size_t i = 0; i < edges.size(); ++i) {
+                int w = segment.weight > 0 ? segment.weight : drawWeight(options, key + i);
+                expanded.insert(expanded.end(), static_cast<std::size_t>(w), edges[i]);
+            }
+            deliver(expanded.data(), expanded.size());
+        }
+    }
+}
+
+void require(bool condition, const char* message) {
+    if (!condition) throw std::invalid_argument(message);
+}
+
+// a vertex count or min cut worked out in 64 bits, which must still fit the int fields of GeneratedGraph
+int checkedInt(std::int64_t value, const char* message) {
+    require(value <= std::numeric_limits<int>::max(), message);
+    return static_cast<int>(value);
+}
+
+}
+
+GeneratedGraph generatePlantedClusters(int clusters, int clusterSize, int cycles, int extraDegree, int bridges,
+                                       const GeneratorOptions& options, const EdgeSink& sink) {
+    require(clusters >= 2 && clusterSize >= 2, "generatePlantedClusters: need at least 2 clusters of 2 vertices");
+    require(cycles >= 1 && extraDegree >= 0, "generatePlantedClusters: need at least one cycle per cluster");
+    require(bridges >= 1 && bridges <= 2 * std::int64_t{cycles}, "generatePlantedClusters: bridges must be in [1, 2 * cycles]");
+
+    GeneratedGraph graph;
+    graph.n = checkedInt(std::int64_t{clusters} * clusterSize, "generatePlantedClusters: more than INT_MAX vertices");
+    graph.minCut = bridges;
+    graph.side.assign(graph.n, 1);
+    std::fill(graph.side.begin(), graph.side.begin() + clusterSize, 0); // cluster 0 against the rest
+
+    std::vector<Segment> segments;
+    for (int c = 0; c < clusters; ++c) {
+        int base = c * clusterSize;
+        for (int k = 0; k < cycles; ++k) {
+            segments.push_back(hamiltonianCycle(base, clusterSize, drawWeight(options, segments.size())));
+        }
+        uniformEdges(segments, base, clusterSize, static_cast<std::size_t>(clusterSize) * extraDegree / 2);
+        if (c + 1 < clusters) segments.push_back(bridgeEdges(base, base + clusterSize, clusterSize, bridges));
+    }
+
+    emit(segments, options, sink, graph);
+    return graph;
+}
+
+GeneratedGraph generateRandomRegular(int n, int degree, const GeneratorOptions& options, const EdgeSink& sink) {
+    require(n >= 3, "generateRandomRegular: need at least 3 vertices");
+    require(degree >= 2 && degree % 2 == 0, "generateRandomRegular: degree must be even and at least 2");
+
+    GeneratedGraph graph;
+    graph.n = n;
+    graph.side.assign(n, 1);
+    graph.side[0] = 0; // every vertex is a min cut on its own
+
+    std::vector<Segment> segments;
+    std::int64_t minCut = 0;
+    for (int k = 0; k < degree / 2; ++k) {
+        int w = drawWeight(options, segments.size());
+        minCut += 2 * std::int64_t{w};
+        segments.push_back(hamiltonianCycle(0, n, w));
+    }
+    graph.minCut = checkedInt(minCut, "generateRandomRegular: weighted degree above INT_MAX");
+
+    emit(segments, options, sink, graph);
+    return graph;
+}
+
+GeneratedGraph generateRmat(int scale, int edgeFactor, int cycles, int bridges, const GeneratorOptions& options, const EdgeSink& sink) {
+    require(scale >= 1 && scale <= 29, "generateRmat: scale must be in [1, 29]");
+    require(edgeFactor >= 0 && cycles >= 1, "generateRmat: need at least one backbone cycle");
+    require(bridges >= 1 && bridges <= 2 * std::int64_t{cycles}, "generateRmat: bridges must be in [1, 2 * cycles]");
+
+    int half = 1 << scale;
+    GeneratedGraph graph;
+    graph.n = 2 * half;
+    graph.minCut = bridges;
+    graph.side.assign(graph.n, 1);
+    std::fill(graph.side.begin(), graph.side.begin() + half, 0);
+
+    std::vector<Segment> segments;
+    for (int s = 0; s < 2; ++s) {
+        int base = s * half;
+        for (int k = 0; k < cycles; ++k) {
+            segments.push_back(hamiltonianCycle(base, half, drawWeight(options, segments.size())));
+        }
+        rmatEdges(segments, base, scale, static_cast<std::size_t>(half) * edgeFactor);
+    }
+    segments.push_back(bridgeEdges(0, half, half, bridges));
+
+    emit(segments, options, sink, graph);
+    return graph;
+}
+
+GeneratedGraph generateGrid(int rows, int cols, bool torus, const GeneratorOptions& options, const EdgeSink& sink) {
+    require(rows >= 1 && cols >= 1 && std::int64_t{rows} * cols >= 2, "generateGrid: need at least 2 vertices");
+    require(!torus || (rows >= 3 && cols >= 3), "generateGrid: a torus needs at least 3 rows and 3 columns");
+
+    // one weight for the whole grid keeps the min cut known
+    int w = drawWeight(options, 0);
+    GeneratedGraph graph;
+    graph.n = checkedInt(std::int64_t{rows} * cols, "generateGrid: more than INT_MAX vertices");
+    graph.minCut = checkedInt(std::int64_t{w} * (torus ? 4 : (rows == 1 || cols == 1) ? 1 : 2), "generateGrid: min cut above INT_MAX");
+    graph.side.assign(graph.n, 1);
+    graph.side[0] = 0; // a corner (or any vertex of a torus)
+
+    std::vector<Segment> segments;
+    int rowsPerBlock = std::max<int>(1, static_cast<int>(kBlockEdges / (2 * static_cast<std::size_t>(cols))));
+    for (int first = 0; first < rows; first += rowsPerBlock) {
+        int last = std::min(rows, first + rowsPerBlock);
+        std::size_t count = 0;
+        for (int r = first; r < last; ++r) {
+            count += torus ? 2 * static_cast<std::size_t>(cols) : (cols - 1) + (r + 1 < rows ? cols : 0);
+        }
+        segments.push_back({count, [rows, cols, torus, first, last](std::mt19937_64&, Edge* out) {
+            for (int r = first; r < last; ++r) {
+                for (int c = 0; c < cols; ++c) {
+                    int v = r * cols + c;
+                    if (torus) {
+                        *out++ = {v, r * cols + (c + 1) % cols};
+                        *out++ = {v, ((r + 1) % rows) * cols + c};
+                        continue;
+                    }
+                    if (c + 1 < cols) *out++ = {v, v + 1};
+                    if (r + 1 < rows) *out++ = {v, v + cols};
+                }
+            }
+        }, w});
+    }
+
+    emit(segments, options, sink, graph);
+    return graph;
+}
+
+}
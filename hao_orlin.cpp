@@ -0,0 +1,324 @@
+/* Hao-Orlin
+The global min cut from a single push-relabel run. Vertex 0 starts as the only source and every other
+vertex is a candidate sink t. Each stage routes as much excess as it can into t inside the awake set W,
+and the excess left at t is then the value of the cut (V \ W, W). t joins the sources, its arcs are
+saturated, and the awake vertex with the lowest label becomes the next sink. Every min cut has vertex 0 on
+the source side and some first sink on the other, and the stage of that sink finds it, so the smallest
+stage value is lambda. That is n - 1 max-flows for the price of one, O(n m log(n^2 / m)) in theory.
+
+Vertices that can no longer reach t through residual arcs inside W fall asleep in dormant sets, kept on a
+stack. A set is woken, newest first, once W runs empty. That gives three sources of dormant sets:
+
+- a relabel that would open a gap: v is the only awake vertex on its label, so v and every awake vertex
+  above it lose their path to t;
+- a vertex with no residual arc into W at all;
+- the global relabel: a reverse breadth-first search from t over residual arcs inside W that sets every
+  reached label to d(t) + its distance and puts the unreached vertices to sleep. It runs whenever the
+  relabels since the last one have scanned about as many arcs as the graph has.
+
+The active vertices of W are kept in buckets by label and discharged highest first. Each label also keeps
+a list of the awake vertices on it, for gaps and for finding the next sink.
+
+Parallel edges collapse into integer capacities; the weighted overload takes a non-negative double per
+edge. Pushes either drain the excess or saturate the arc exactly, so doubles never leave a sliver behind.
+*/
+
+#include "karger.hpp"
+#include "pair_weights.hpp"
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace karger {
+
+namespace {
+
+template <class Index, class Weight>
+class HaoOrlin {
+public:
+    // arcs as (tail, head, capacity) triples; each undirected pair becomes two opposite arcs
+    HaoOrlin(Index n, const std::vector<std::tuple<Index, Index, Weight>>& pairs)
+        : n_(n), first_(static_cast<std::size_t>(n) + 1, 0) {
+        for (const auto& [a, b, w] : pairs) {
+            ++first_[a + 1];
+            ++first_[b + 1];
+        }
+        for (Index v = 0; v < n; ++v) first_[v + 1] += first_[v];
+        head_.resize(first_[n]);
+        rev_.resize(first_[n]);
+        res_.resize(first_[n]);
+        std::vector<std::size_t> fill(first_.begin(), first_.end() - 1);
+        for (const auto& [a, b, w] : pairs) {
+            std::size_t i = fill[a]++, j = fill[b]++;
+            head_[i] = b;
+            head_[j] = a;
+            rev_[i] = j;
+            rev_[j] = i;
+            res_[i] = w;
+            res_[j] = w;
+        }
+    }
+
+    Weight run() {
+        state_.assign(n_, State::Awake);
+        label_.assign(n_, 0);
+        excess_.assign(n_, 0);
+        cur_.assign(first_.begin(), first_.end() - 1);
+        pos_.assign(n_, 0);
+        layer_.assign(2 * static_cast<std::size_t>(n_) + 2, {});
+        active_.assign(layer_.size(), {});
+        seen_.assign(n_, 0);
+        for (Index v = 1; v < n_; ++v) addToLayer(v);
+        state_[0] = State::Source;
+        saturateFrom(0);
+
+        Weight best = std::numeric_limits<Weight>::max();
+        Index t = lowestAwake(0);
+        for (Index sources = 1;; ++sources) {
+            sink_ = t;
+            discharge();
+            best = std::min(best, excess_[t]);
+            if (sources + 1 == n_ || best == 0) break;
+
+            removeFromLayer(t);
+            state_[t] = State::Source;
+            saturateFrom(t);
+            Index from = label_[t];
+            if (awakeCount_ == 0) from = wake();
+            t = lowestAwake(from);
+        }
+        return best;
+    }
+
+private:
+    enum class State : std::uint8_t { Source, Awake, Dormant };
+
+    void addToLayer(Index v) {
+        ensureLabel(label_[v]);
+        auto& layer = layer_[label_[v]];
+        pos_[v] = static_cast<Index>(layer.size());
+        layer.push_back(v);
+        awakeTop_ = std::max(awakeTop_, label_[v]);
+        ++awakeCount_;
+    }
+
+    void removeFromLayer(Index v) {
+        auto& layer = layer_[label_[v]];
+        Index last = layer.back();
+        layer[pos_[v]] = last;
+        pos_[last] = pos_[v];
+        layer.pop_back();
+        --awakeCount_;
+    }
+
+    void ensureLabel(Index l) {
+        if (static_cast<std::size_t>(l) >= layer_.size()) {
+            layer_.resize(2 * static_cast<std::size_t>(l) + 1);
+            active_.resize(layer_.size());
+        }
+    }
+
+    void activate(Index v) {
+        active_[label_[v]].push_back(v);
+        highest_ = std::max(highest_, label_[v]);
+    }
+
+    Index lowestAwake(Index from) const {
+        while (layer_[from].empty()) ++from;
+        return layer_[from].back();
+    }
+
+    // the newest dormant set becomes W; returns its lowest label
+    Index wake() {
+        std::vector<Index> set = std::move(dormant_.back());
+        dormant_.pop_back();
+        Index low = std::numeric_limits<Index>::max();
+        for (Index v : set) {
+            state_[v] = State::Awake;
+            cur_[v] = first_[v];
+            addToLayer(v);
+            low = std::min(low, label_[v]);
+            if (excess_[v] > 0) activate(v);
+        }
+        return low;
+    }
+
+    void sleep(std::vector<Index>&& set) {
+        for (Index v : set) state_[v] = State::Dormant;
+        dormant_.push_back(std::move(set));
+    }
+
+    void saturateFrom(Index s) {
+        for (std::size_t i = first_[s]; i < first_[s + 1]; ++i) {
+            Index y = head_[i];
+            if (state_[y] == State::Source || res_[i] == 0) continue;
+            bool idle = excess_[y] == 0;
+            excess_[y] += res_[i];
+            res_[rev_[i]] += res_[i];
+            res_[i] = 0;
+            if (idle && state_[y] == State::Awake && y != sink_) activate(y);
+        }
+    }
+
+    void discharge() {
+        std::size_t arcs = first_[n_] + static_cast<std::size_t>(n_);
+        for (;;) {
+            while (highest_ > 0 && active_[highest_].empty()) --highest_;
+            if (active_[highest_].empty()) return;
+            Index v = active_[highest_].back();
+            active_[highest_].pop_back();
+            if (state_[v] != State::Awake || v == sink_ || excess_[v] == 0 || label_[v] != highest_) continue;
+
+            while (excess_[v] > 0 && state_[v] == State::Awake) {
+                if (!pushFrom(v)) relabel(v);
+            }
+            if (relabelWork_ > arcs) globalRelabel();
+        }
+    }
+
+    // pushes along admissible arcs from the current arc on; false once they run out
+    bool pushFrom(Index v) {
+        for (std::size_t& i = cur_[v]; i < first_[v + 1]; ++i) {
+            Index y = head_[i];
+            if (res_[i] == 0 || state_[y] != State::Awake || label_[v] != label_[y] + 1) continue;
+            bool idle = excess_[y] == 0;
+            if (excess_[v] <= res_[i]) {
+                res_[i] -= excess_[v];
+                res_[rev_[i]] += excess_[v];
+                excess_[y] += excess_[v];
+                excess_[v] = 0;
+            } else {
+                excess_[v] -= res_[i];
+                res_[rev_[i]] += res_[i];
+                excess_[y] += res_[i];
+                res_[i] = 0;
+            }
+            if (idle && y != sink_) activate(y);
+            if (excess_[v] == 0) return true;
+        }
+        return false;
+    }
+
+    void relabel(Index v) {
+        Index l = label_[v];
+        if (layer_[l].size() == 1) {
+            // gap: v and everything awake above it lost their way to the sink
+            std::vector<Index> set;
+            for (Index k = l; k <= awakeTop_; ++k) {
+                for (Index x : layer_[k]) set.push_back(x);
+                awakeCount_ -= static_cast<Index>(layer_[k].size());
+                layer_[k].clear();
+            }
+            awakeTop_ = l - 1;
+            sleep(std::move(set));
+            return;
+        }
+
+        Index low = std::numeric_limits<Index>::max();
+        for (std::size_t i = first_[v]; i < first_[v + 1]; ++i) {
+            if (res_[i] > 0 && state_[head_[i]] == State::Awake) low = std::min(low, label_[head_[i]]);
+        }
+        relabelWork_ += first_[v + 1] - first_[v] + 1;
+        removeFromLayer(v);
+        cur_[v] = first_[v];
+        if (low == std::numeric_limits<Index>::max()) {
+            sleep({v});
+            return;
+        }
+        label_[v] = low + 1;
+        addToLayer(v);
+    }
+
+    // exact distances to the sink inside W; whatever cannot reach it goes to sleep
+    void globalRelabel() {
+        relabelWork_ = 0;
+        std::vector<Index> awake;
+        for (Index k = 0; k <= awakeTop_; ++k) {
+            for (Index x : layer_[k]) awake.push_back(x);
+            layer_[k].clear();
+        }
+        awakeCount_ = 0;
+        awakeTop_ = 0;
+        for (auto& bucket : active_) bucket.clear();
+        highest_ = 0;
+
+        for (Index x : awake) seen_[x] = 0;
+        seen_[sink_] = 1;
+        std::vector<Index> queue{sink_};
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            Index y = queue[q];
+            for (std::size_t i = first_[y]; i < first_[y + 1]; ++i) {
+                Index x = head_[i];
+                if (state_[x] != State::Awake || seen_[x] || res_[rev_[i]] == 0) continue;
+                seen_[x] = 1;
+                label_[x] = label_[y] + 1;
+                queue.push_back(x);
+            }
+        }
+
+        std::vector<Index> unreached;
+        for (Index x : awake) {
+            if (!seen_[x]) {
+                unreached.push_back(x);
+                continue;
+            }
+            cur_[x] = first_[x];
+            addToLayer(x);
+            if (x != sink_ && excess_[x] > 0) activate(x);
+        }
+        if (!unreached.empty()) sleep(std::move(unreached));
+    }
+
+    Index n_;
+    std::vector<std::size_t> first_, cur_, rev_;
+    std::vector<Index> head_;
+    std::vector<Weight> res_;
+
+    std::vector<State> state_;
+    std::vector<Index> label_, pos_;
+    std::vector<Weight> excess_;
+    std::vector<std::vector<Index>> layer_, active_, dormant_;
+    std::vector<char> seen_;
+    Index awakeTop_ = 0, awakeCount_ = 0, highest_ = 0, sink_ = 0;
+    std::size_t relabelWork_ = 0;
+};
+
+template <class Index>
+Index haoOrlin(Index n, std::span<const BasicEdge<Index>> edges) {
+    if (n <= 1) return 0;
+    std::vector<std::tuple<Index, Index, long long>> pairs;
+    for (const auto& [a, b, w] : detail::collapseParallelEdges<long long>(edges)) pairs.push_back({a, b, w});
+    return static_cast<Index>(HaoOrlin<Index, long long>(n, pairs).run());
+}
+
+template <class Index>
+double haoOrlinWeighted(Index n, std::span<const BasicEdge<Index>> edges, std::span<const double> weights) {
+    if (edges.size() != weights.size()) throw std::invalid_argument("minCutHaoOrlin needs one weight per edge");
+    if (n <= 1) return 0.0;
+    std::vector<std::tuple<Index, Index, double>> pairs;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (weights[i] < 0.0) throw std::invalid_argument("minCutHaoOrlin needs non-negative weights");
+        if (edges[i].u != edges[i].v) pairs.push_back({edges[i].u, edges[i].v, weights[i]});
+    }
+    return HaoOrlin<Index, double>(n, pairs).run();
+}
+
+}
+
+int minCutHaoOrlin(int n, std::span<const Edge> edges) {
+    return haoOrlin(n, detail::intEdges(edges));
+}
+
+std::int64_t minCutHaoOrlin(std::int64_t n, std::span<const Edge64> edges) {
+    return haoOrlin(n, edges);
+}
+
+double minCutHaoOrlin(int n, std::span<const Edge> edges, std::span<const double> weights) {
+    return haoOrlinWeighted(n, detail::intEdges(edges), weights);
+}
+
+double minCutHaoOrlin(std::int64_t n, std::span<const Edge64> edges, std::span<const double> weights) {
+    return haoOrlinWeighted(n, edges, weights);
+}
+
+}
@@ -0,0 +1,162 @@
+/* Minimum k-cut
+The contraction engines stop at two supernodes; stopping at k instead leaves a k-partition whose value is
+the number of edges between different parts. A fixed minimum k-cut survives one contraction to k
+supernodes with probability at least about n^-2(k-1), so
+
+- minKCut repeats plain contraction (a shuffled edge order through UnionFind, reset in O(touched)
+  between trials) and keeps the best partition.
+- minKCutRecursive is the Karger-Stein recursion with the stop moved to k: each level contracts to
+  k + (s - k) / sqrt(2) supernodes and branches twice, sharing one RollbackUnionFind across the branches
+  like minCutKargerStein, and each leaf finishes with a single contraction to k. The shrink that keeps
+  the k-cut's survival at 1/2 per level, 2^(1 / (2(k-1))), makes the tree O(n^(2(k-1))) leaves, already
+  minutes for k = 3 on a few hundred vertices, so the sqrt(2) shrink of the 2-cut recursion is kept and
+  one run is a cheap, much likelier trial rather than a guarantee; repeat it with fresh seeds.
+
+Graphs with k or more components are answered directly: the components, merged down to k parts, cut
+nothing. Parts are numbered 0..k-1 in order of their lowest vertex.
+*/
+
+#include "karger.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+// parts numbered by their lowest vertex, from any find function
+template <class Index, class Find>
+std::vector<Index> labelParts(Index n, Find find) {
+    std::vector<Index> label(n, -1), part(n);
+    Index next = 0;
+    for (Index v = 0; v < n; ++v) {
+        Index r = find(v);
+        if (label[r] == -1) label[r] = next++;
+        part[v] = label[r];
+    }
+    return part;
+}
+
+template <class Index>
+void checkK(Index n, Index k) {
+    if (k < 1 || k > std::max<Index>(n, 1)) throw std::invalid_argument("minKCut needs 1 <= k <= n");
+}
+
+// when the graph has k or more components the answer costs nothing: merge surplus components into the
+// last part. Returns false (and leaves `out` alone) when there are fewer than k components.
+template <class Index>
+bool componentsCut(Index n, std::span<const BasicEdge<Index>> edges, Index k, BasicKCut<Index>& out) {
+    UnionFind<Index> uf(n);
+    for (const auto& e : edges) uf.unite(e.u, e.v);
+    if (uf.components() < k) return false;
+    out.value = 0;
+    out.part = labelParts(n, [&uf](Index v) { return uf.find(v); });
+    for (Index& p : out.part) p = std::min(p, k - 1);
+    return true;
+}
+
+template <class Index>
+BasicKCut<Index> repeated(Index n, std::span<const BasicEdge<Index>> edges, Index k, std::size_t trials, std::uint64_t seed) {
+    checkK(n, k);
+    BasicKCut<Index> best;
+    if (componentsCut(n, edges, k, best)) return best;
+
+    std::mt19937_64 rng(seed);
+    std::vector<std::size_t> order(edges.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    UnionFind<Index> uf(n);
+    best.value = std::numeric_limits<Index>::max();
+    for (std::size_t t = 0; t < std::max<std::size_t>(trials, 1); ++t) {
+        std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t i : order) {
+            if (uf.components() <= k) break;
+            uf.unite(edges[i].u, edges[i].v);
+        }
+        Index value = 0;
+        for (const auto& e : edges) value += !uf.same(e.u, e.v);
+        if (value < best.value) {
+            best.value = value;
+            best.part = labelParts(n, [&uf](Index v) { return uf.find(v); });
+        }
+        uf.reset();
+    }
+    return best;
+}
+
+template <class Index>
+struct KRecursion {
+    RollbackUnionFind<Index>& uf;
+    Index n, k;
+    std::mt19937_64& rng;
+    BasicKCut<Index>& best;
+
+    // contracts a shuffled copy of `edges` down to `target`, leaving the edges that still cross (as roots) in `out`
+    Index contract(Index supernodes, std::span<const BasicEdge<Index>> edges, Index target, std::vector<BasicEdge<Index>>& out) {
+        out.assign(edges.begin(), edges.end());
+        std::shuffle(out.begin(), out.end(), rng);
+        for (const auto& e : out) {
+            if (supernodes <= target) break;
+            if (uf.unite(e.u, e.v)) --supernodes;
+        }
+        out.clear();
+        for (const auto& e : edges) {
+            Index a = uf.find(e.u);
+            Index b = uf.find(e.v);
+            if (a != b) out.push_back({a, b});
+        }
+        return supernodes;
+    }
+
+    void run(Index supernodes, std::span<const BasicEdge<Index>> edges) {
+        Index target = k + static_cast<Index>(std::ceil((supernodes - k) / std::sqrt(2.0)));
+        bool leaf = target >= supernodes || supernodes <= k + 4;
+        std::vector<BasicEdge<Index>> crossing;
+        for (int branch = 0; branch < (leaf ? 1 : 2); ++branch) {
+            std::size_t mark = uf.checkpoint();
+            Index left = contract(supernodes, edges, leaf ? k : target, crossing);
+            if (!leaf) {
+                run(left, crossing);
+            } else if (static_cast<Index>(crossing.size()) < best.value) {
+                best.value = static_cast<Index>(crossing.size());
+                best.part = labelParts(n, [this](Index v) { return uf.find(v); });
+            }
+            uf.rollback(mark);
+        }
+    }
+};
+
+template <class Index>
+BasicKCut<Index> recursive(Index n, std::span<const BasicEdge<Index>> edges, Index k, std::uint64_t seed) {
+    checkK(n, k);
+    BasicKCut<Index> best;
+    if (componentsCut(n, edges, k, best)) return best;
+
+    best.value = std::numeric_limits<Index>::max();
+    RollbackUnionFind<Index> uf(n);
+    std::mt19937_64 rng(seed);
+    KRecursion<Index> recursion{uf, n, k, rng, best};
+    recursion.run(n, edges);
+    return best;
+}
+
+}
+
+KCut minKCut(int n, std::span<const Edge> edges, int k, std::size_t trials, std::uint64_t seed) {
+    return repeated(n, detail::intEdges(edges), k, trials, seed);
+}
+
+KCut64 minKCut(std::int64_t n, std::span<const Edge64> edges, std::int64_t k, std::size_t trials, std::uint64_t seed) {
+    return repeated(n, edges, k, trials, seed);
+}
+
+KCut minKCutRecursive(int n, std::span<const Edge> edges, int k, std::uint64_t seed) {
+    return recursive(n, detail::intEdges(edges), k, seed);
+}
+
+KCut64 minKCutRecursive(std::int64_t n, std::span<const Edge64> edges, std::int64_t k, std::uint64_t seed) {
+    return recursive(n, edges, k, seed);
+}
+
+}
@@ -2,19 +2,50 @@
 #define KARGER_HPP
 
 #include <vector>
+#include <span>
 #include <utility>
 #include <string>
 #include <cstddef>
 #include <cstdint>
-#include <iostream>
 #include <algorithm>
 #include <unordered_map>
+#include <functional>
+#include <cstdio>
+#include <iosfwd>
+#include <limits>
+#include <stdexcept>
+#include "union_find.hpp"
 
 namespace karger {
-    struct Edge { int u, v; };
+    // one edge type per index width: Index is the vertex id type and also the cut value type. Weights are
+    // tied to it too, there is no separate weight parameter: a weight is a count of parallel edges, summed
+    // in Index (only the overloads taking a double per edge differ). A cut never exceeds m, so the int
+    // overloads throw std::invalid_argument for more than INT_MAX edges instead of overflowing.
+    // Edge (32-bit) keeps edges at 8 bytes for everyday graphs; Edge64 lifts the 2^31 limit on vertices
+    // and edges. Every engine except degree-biased contraction is one template over the index type behind
+    // a pair of overloads, so both widths run the same code.
+    template <class Index>
+    struct BasicEdge { Index u, v; };
 
-    // find function for disjoint set
-    inline int findParent(std::vector<int>& parent, int x) {
+    using Edge = BasicEdge<int>;
+    using Edge64 = BasicEdge<std::int64_t>;
+
+    namespace detail {
+        // the check every int overload runs on its edges before handing them to the shared template
+        inline std::span<const Edge> intEdges(std::span<const Edge> edges) {
+            if (edges.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+                throw std::invalid_argument("more than INT_MAX edges need the Edge64 overloads");
+            return edges;
+        }
+    }
+
+    // every engine reads its edges through std::span<const Edge>, so a std::vector<Edge>, a plain array or
+    // a memory-mapped MappedGraph::edges() can be passed without a copy
+
+    // free-function disjoint set over caller-owned vectors. The engines use UnionFind (union_find.hpp);
+    // these stay as the baseline bench/union_find_bench measures it against
+    template <class Index>
+    inline Index findParent(std::vector<Index>& parent, Index x) {
         while (parent[x] != x) {
             parent[x] = parent[parent[x]]; // move up two levels at a time
             x = parent[x];
@@ -23,7 +54,8 @@ namespace karger {
     }
 
     // union function for disjoint set
-    inline bool unionSets(std::vector<int>& parent, std::vector<int>& rank, int a, int b) {
+    template <class Index, class Rank>
+    inline bool unionSets(std::vector<Index>& parent, std::vector<Rank>& rank, Index a, Index b) {
         a = findParent(parent, a);
         b = findParent(parent, b);
         if (a == b) return false;
@@ -37,13 +69,472 @@ namespace karger {
         return true;
     }
 
+    // opt-in tracing for the contraction engines
+    // onContraction: supernodes a and b were merged, `supernodes` remain
+    // onTrialComplete: one contraction run finished with cut `cut` (trial is the seed for randomised runs)
+    // onResult: the value the engine is about to return
+    struct Observer {
+        virtual ~Observer() = default;
+        virtual void onContraction(std::int64_t /*a*/, std::int64_t /*b*/, std::int64_t /*supernodes*/) {}
+        virtual void onTrialComplete(std::uint64_t /*trial*/, std::int64_t /*cut*/) {}
+        virtual void onResult(std::int64_t /*cut*/) {}
+    };
+
+    // used by the overloads without an observer, every hook is an empty inline call
+    struct NullObserver {
+        void onContraction(std::int64_t, std::int64_t, std::int64_t) {}
+        void onTrialComplete(std::uint64_t, std::int64_t) {}
+        void onResult(std::int64_t) {}
+    };
+
     // Dominic S
-    int minCutRandomised(int n, const std::vector<Edge>& edges, std::uint64_t seed);
+    int minCutRandomised(int n, std::span<const Edge> edges, std::uint64_t seed);
+    int minCutRandomised(int n, std::span<const Edge> edges, std::uint64_t seed, Observer& observer);
+    std::int64_t minCutRandomised(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed);
+    std::int64_t minCutRandomised(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed, Observer& observer);
+
+    // one Karger trial as a random-priority spanning forest built by parallel Boruvka: the distribution of
+    // minCutRandomised, not the same cut for the same seed; threads = 0 means one per hardware thread
+    int minCutRandomisedParallel(int n, std::span<const Edge> edges, std::uint64_t seed, int threads = 0);
+    std::int64_t minCutRandomisedParallel(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed, int threads = 0);
 
     // Domenic C
-    int minCutFixedPermutation(int n, const std::vector<Edge>& edges);
+    int minCutFixedPermutation(int n, std::span<const Edge> edges);
+    int minCutFixedPermutation(int n, std::span<const Edge> edges, Observer& observer);
+    std::int64_t minCutFixedPermutation(std::int64_t n, std::span<const Edge64> edges);
+    std::int64_t minCutFixedPermutation(std::int64_t n, std::span<const Edge64> edges, Observer& observer);
+
+    // the same contraction as a spanning forest built by parallel Boruvka, always the cut minCutFixedPermutation
+    // returns whatever the thread count; threads = 0 means one per hardware thread
+    int minCutFixedPermutationParallel(int n, std::span<const Edge> edges, int threads = 0);
+    std::int64_t minCutFixedPermutationParallel(std::int64_t n, std::span<const Edge64> edges, int threads = 0);
 
     // Jared S
+    int deterministic_degree_biased_karger(int n, std::span<const Edge> edges);
+    int deterministic_degree_biased_karger(int n, const std::vector<std::pair<int,int>>& edges); // original pair input
+
+    // Exact engines
+    // brute force over every bipartition, O(2^(n-1) * n), returns -1 when n > 30
+    int minCutBitmask(int n, std::span<const Edge> edges);
+    std::int64_t minCutBitmask(std::int64_t n, std::span<const Edge64> edges);
+
+    // Stoer-Wagner on an n x n weight matrix, O(n^3) time and O(n^2) memory
+    int minCutStoerWagnerDense(int n, std::span<const Edge> edges);
+    std::int64_t minCutStoerWagnerDense(std::int64_t n, std::span<const Edge64> edges);
+
+    // Stoer-Wagner on collapsed adjacency lists with a lazy heap, O(n * m log m)
+    int minCutStoerWagner(int n, std::span<const Edge> edges);
+    std::int64_t minCutStoerWagner(std::int64_t n, std::span<const Edge64> edges);
+    // the same over a non-negative weight per edge (weights.size() == edges.size(), else std::invalid_argument)
+    double minCutStoerWagner(int n, std::span<const Edge> edges, std::span<const double> weights);
+    double minCutStoerWagner(std::int64_t n, std::span<const Edge64> edges, std::span<const double> weights);
+
+    // Hao-Orlin: every sink of one push-relabel run, with highest-label selection, gaps and global
+    // relabelling; exact, O(n m log(n^2 / m)). The weighted overload follows minCutStoerWagner's rules
+    int minCutHaoOrlin(int n, std::span<const Edge> edges);
+    std::int64_t minCutHaoOrlin(std::int64_t n, std::span<const Edge64> edges);
+    double minCutHaoOrlin(int n, std::span<const Edge> edges, std::span<const double> weights);
+    double minCutHaoOrlin(std::int64_t n, std::span<const Edge64> edges, std::span<const double> weights);
+
+    // Matula's (2 + eps)-approximation: the value of a real cut, between lambda and (2 + eps) lambda, in
+    // O(m / eps) after collapsing parallel edges; eps <= 0 throws std::invalid_argument
+    int minCutApproxMatula(int n, std::span<const Edge> edges, double eps);
+    std::int64_t minCutApproxMatula(std::int64_t n, std::span<const Edge64> edges, double eps);
+
+    // Karger-Stein recursive contraction, one run (succeeds with probability >= 1 / (log2 n + 1))
+    int minCutKargerStein(int n, std::span<const Edge> edges, std::uint64_t seed);
+    std::int64_t minCutKargerStein(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed);
+
+    // Minimum k-cut
+    // a k-partition and the number of edges between different parts; part[v] is in [0, k), parts
+    // numbered in order of their lowest vertex. k outside [1, n] throws std::invalid_argument.
+    template <class Index>
+    struct BasicKCut {
+        Index value = 0;
+        std::vector<Index> part;
+    };
+
+    using KCut = BasicKCut<int>;
+    using KCut64 = BasicKCut<std::int64_t>;
+
+    // best of `trials` contractions to k supernodes
+    KCut minKCut(int n, std::span<const Edge> edges, int k, std::size_t trials, std::uint64_t seed);
+    KCut64 minKCut(std::int64_t n, std::span<const Edge64> edges, std::int64_t k, std::size_t trials, std::uint64_t seed);
+
+    // one Karger-Stein style recursive contraction run down to k supernodes
+    KCut minKCutRecursive(int n, std::span<const Edge> edges, int k, std::uint64_t seed);
+    KCut64 minKCutRecursive(std::int64_t n, std::span<const Edge64> edges, std::int64_t k, std::uint64_t seed);
+
+    // minCutStoerWagner with the cut itself: a 2-cut whose part 0 holds vertex 0
+    KCut minCutStoerWagnerPartition(int n, std::span<const Edge> edges);
+    KCut64 minCutStoerWagnerPartition(std::int64_t n, std::span<const Edge64> edges);
+
+    // Contraction dendrogram
+    // the merge order of one contraction run, built from the (a, b) pairs in step order: merge i joins the
+    // supernodes holding vertices a and b and leaves n - 1 - i supernodes. Levels run from k = n down to
+    // minSupernodes() (2 for a connected graph, since the engines stop there); queries clamp k to that range.
+    template <class Index>
+    class BasicDendrogram {
+    public:
+        struct Merge { Index a, b; };
+
+        BasicDendrogram() = default;
+        BasicDendrogram(Index n, std::span<const BasicEdge<Index>> edges, std::vector<Merge> merges);
+
+        Index vertices() const { return n_; }
+        Index minSupernodes() const { return n_ - static_cast<Index>(merges_.size()); }
+        const std::vector<Merge>& merges() const { return merges_; }
+
+        // representative vertex of v's supernode when k supernodes remain, O(log n)
+        Index supernode(Index v, Index k) const;
+        // every vertex of v's supernode when k supernodes remain, O(log n) plus the output
+        std::span<const Index> members(Index v, Index k) const;
+        // edges running between different supernodes when k remain (for k = 2, the engine's cut), O(1)
+        Index cutAt(Index k) const;
+
+    private:
+        Index steps(Index k) const; // merges applied at level k
+
+        Index n_ = 0;
+        std::vector<Merge> merges_;
+        std::vector<Index> parent_;       // union by rank, no compression, so every level stays readable
+        std::vector<Index> linkedAt_;     // merge that made a vertex a non-root, n - 1 for roots
+        std::vector<Index> survivorBegin_; // CSR over vertices: the merges each vertex survived as root
+        std::vector<Index> survivorSteps_;
+        std::vector<Index> order_;        // vertices in merge tree order, every supernode is a range of it
+        std::vector<Index> rangeBegin_;   // per merge tree node (vertices, then merges), size is rangeSize_
+        std::vector<Index> rangeSize_;
+        std::vector<Index> crossing_ = std::vector<Index>(1, 0); // crossing_[s]: non-loop edges between supernodes after s merges
+    };
+
+    extern template class BasicDendrogram<int>;
+    extern template class BasicDendrogram<std::int64_t>;
+    using Dendrogram = BasicDendrogram<int>;
+    using Dendrogram64 = BasicDendrogram<std::int64_t>;
+
+    // an observer (for the templated engine bodies) that keeps every onContraction pair in order
+    template <class Index>
+    struct MergeRecorder {
+        std::vector<typename BasicDendrogram<Index>::Merge> merges;
+        void onContraction(std::int64_t a, std::int64_t b, std::int64_t) {
+            merges.push_back({static_cast<Index>(a), static_cast<Index>(b)});
+        }
+        void onTrialComplete(std::uint64_t, std::int64_t) {}
+        void onResult(std::int64_t) {}
+    };
+
+    // one minCutRandomised / minCutFixedPermutation run with its merges recorded
+    Dendrogram contractionDendrogramRandomised(int n, std::span<const Edge> edges, std::uint64_t seed);
+    Dendrogram64 contractionDendrogramRandomised(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed);
+    Dendrogram contractionDendrogramFixedPermutation(int n, std::span<const Edge> edges);
+    Dendrogram64 contractionDendrogramFixedPermutation(std::int64_t n, std::span<const Edge64> edges);
+
+    // All minimum cuts
+    // every min cut of the graph as a cactus: node[v] is the cactus node holding vertex v (nodes may hold
+    // no vertex), and each min cut is either one tree edge or two edges of one cycle removed, splitting the
+    // nodes and so the vertices in two. cycles list their nodes in ring order. A disconnected graph gets
+    // one node per component and no edges (minCut 0, every grouping of components is a min cut).
+    template <class Index>
+    struct BasicCactus {
+        Index minCut = 0;
+        Index nodes = 0;
+        std::vector<Index> node;
+        std::vector<BasicEdge<Index>> treeEdges;
+        std::vector<std::vector<Index>> cycles;
+
+        // number of min cuts represented: one per tree edge, r (r - 1) / 2 per cycle of length r
+        std::size_t cutCount() const;
+    };
+
+    extern template struct BasicCactus<int>;
+    extern template struct BasicCactus<std::int64_t>;
+    using Cactus = BasicCactus<int>;
+    using Cactus64 = BasicCactus<std::int64_t>;
+
+    // exact: n - 1 max flows, each stopped once it passes lambda, plus O(n + m) per flow to read its chain
+    // of min cuts; O(n + m) memory beyond the output, the cuts themselves are never listed
+    Cactus minCutCactus(int n, std::span<const Edge> edges);
+    Cactus64 minCutCactus(std::int64_t n, std::span<const Edge64> edges);
+
+    // Near-minimum cuts
+    // receives each cut once, as its value and the sorted vertices of the side without vertex 0; the span
+    // is only valid during the call
+    template <class Index>
+    using BasicCutSink = std::function<void(Index value, std::span<const Index> side)>;
+    using CutSink = BasicCutSink<int>;
+    using CutSink64 = BasicCutSink<std::int64_t>;
+
+    // trials after which every cut of value <= alpha * min cut has been streamed with probability
+    // >= 1 - errorProbability (saturates at SIZE_MAX)
+    std::size_t nearMinCutTrials(std::int64_t n, double alpha, double errorProbability);
+
+    // streams every distinct cut of value <= alpha * min cut found by `trials` contractions to ceil(2 alpha)
+    // supernodes, each followed by all bipartitions of what is left; returns how many were streamed.
+    // alpha outside [1, 10] throws std::invalid_argument, as does a graph with more than 20 components.
+    std::size_t enumerateNearMinCuts(int n, std::span<const Edge> edges, double alpha, std::size_t trials, std::uint64_t seed,
+                                     const CutSink& sink);
+    std::size_t enumerateNearMinCuts(std::int64_t n, std::span<const Edge64> edges, double alpha, std::size_t trials,
+                                     std::uint64_t seed, const CutSink64& sink);
+
+    // Cut sparsifier
+    // a reweighted sample of the graph whose cuts match the original's in expectation: distinct vertex
+    // pairs, each with the weight it stands for. Every cut lands within 1 +- eps with probability 1 - O(1/n)
+    template <class Index>
+    struct BasicSparsifiedGraph {
+        Index n = 0;
+        std::vector<BasicEdge<Index>> edges;
+        std::vector<double> weights;
+    };
+
+    using SparsifiedGraph = BasicSparsifiedGraph<int>;
+    using SparsifiedGraph64 = BasicSparsifiedGraph<std::int64_t>;
+
+    // Benczur-Karger sampling at rho = 15 ln n / eps^2 over certified lower bounds on edge strength,
+    // O(n log n / eps^2) edges expected; graphs much denser than that shrink (see sparsifier.cpp).
+    // eps outside (0, 1] throws std::invalid_argument
+    SparsifiedGraph sparsifyCuts(int n, std::span<const Edge> edges, double eps, std::uint64_t seed);
+    SparsifiedGraph64 sparsifyCuts(std::int64_t n, std::span<const Edge64> edges, double eps, std::uint64_t seed);
+
+    // weighted Hao-Orlin on sparsifyCuts' output: within 1 +- eps of the min cut with probability 1 - O(1/n)
+    double minCutSparsified(int n, std::span<const Edge> edges, double eps, std::uint64_t seed);
+    double minCutSparsified(std::int64_t n, std::span<const Edge64> edges, double eps, std::uint64_t seed);
+
+    // Network reliability
+    // probability that the graph disconnects when every edge fails independently with probability pFail,
+    // within a factor 1 +- eps with probability >= 0.99 (Karger's FPRAS over the near-minimum cuts, or plain
+    // sampling when that is cheaper). p outside [0, 1] or eps outside (0, 1) throws std::invalid_argument.
+    // The estimate depends on seed only, threads (0 = hardware) just splits the samples.
+    double disconnectionProbability(int n, std::span<const Edge> edges, double pFail, double eps, std::uint64_t seed = 0,
+                                    int threads = 0);
+    double disconnectionProbability(std::int64_t n, std::span<const Edge64> edges, double pFail, double eps,
+                                    std::uint64_t seed = 0, int threads = 0);
+
+    // Dispatcher
+    enum class Guarantee {
+        Exact,      // always the true min cut
+        MonteCarlo, // true min cut with probability >= 1 - errorProbability
+        Heuristic,  // some cut, as cheaply as possible
+        Approximate // a cut within 1 + epsilon of the min cut with probability >= 1 - errorProbability
+    };
+
+    enum class Engine {
+        Trivial, Bitmask, StoerWagnerDense, StoerWagner, Randomised, KargerStein, FixedPermutation, DegreeBiased,
+        SampledStoerWagner, HaoOrlin
+    };
+
+    struct MinCutOptions {
+        Guarantee guarantee = Guarantee::Exact;
+        double errorProbability = 1e-3;
+        double epsilon = 0.1; // Approximate only, in (0, 1], anything else throws std::invalid_argument
+        std::uint64_t seed = 1;
+
+        // cost model knobs
+        int bitmaskMaxVertices = 24;
+        int denseMaxVertices = 4096;
+        double degreeBiasedBudget = 1e7; // Heuristic uses degree-biased contraction while its cost stays under this
+        bool haoOrlin = true; // false leaves sparse exact work to Stoer-Wagner
+
+        int threads = 0; // for the connectivity check, 0 = one per hardware thread; never changes the answer
+
+        // receives onTrialComplete for every run (trial index) and onResult once, nullptr for none
+        Observer* observer = nullptr;
+    };
+
+    // what the dispatcher saw, what it picked and how long each stage took
+    struct MinCutReport {
+        Engine engine = Engine::Trivial; // Trivial for n <= 1, no edges or a disconnected graph
+        std::int64_t n = 0;
+        std::size_t m = 0;
+        std::size_t distinctPairs = 0;
+        std::size_t maxMultiplicity = 0;
+        double density = 0.0; // distinctPairs / (n choose 2)
+        bool connected = false;
+        std::size_t minDegree = 0; // non-loop edges at the least connected vertex, an upper bound on the min cut
+        std::size_t trials = 0;
+        double estimatedCost = 0.0;
+        double analyseSeconds = 0.0;
+        double solveSeconds = 0.0;
+    };
+
+    const char* engineName(Engine engine);
+
+    // route to the cheapest engine that honours options.guarantee
+    int minCut(int n, std::span<const Edge> edges, const MinCutOptions& options = {}, MinCutReport* report = nullptr);
+    std::int64_t minCut(std::int64_t n, std::span<const Edge64> edges, const MinCutOptions& options = {}, MinCutReport* report = nullptr);
+
+    // Generators
+    // graph families with a min cut known by construction; the output depends only on the arguments
+    // and options.seed, never on options.threads. Invalid parameters throw std::invalid_argument.
+
+    // receives the generated edges in consecutive chunks, in order, on the calling thread
+    using EdgeSink = std::function<void(const Edge* edges, std::size_t count)>;
+
+    struct GeneratorOptions {
+        std::uint64_t seed = 1;
+        int threads = 0;   // 0 = one per hardware thread
+        int maxWeight = 1; // > 1 draws integer weights in [1, maxWeight], emitted as parallel edges
+    };
+
+    struct GeneratedGraph {
+        int n = 0;
+        std::size_t m = 0;
+        std::vector<Edge> edges; // left empty when the edges went to a sink
+        int minCut = 0;
+        std::vector<std::uint8_t> side; // side[v] is 0 or 1, a partition achieving minCut
+    };
+
+    // `clusters` groups of `clusterSize` vertices, each the union of `cycles` random Hamiltonian cycles
+    // plus clusterSize * extraDegree / 2 random internal edges, consecutive groups joined by `bridges`
+    // unit edges (bridges <= 2 * cycles); min cut = bridges, cluster 0 against the rest
+    GeneratedGraph generatePlantedClusters(int clusters, int clusterSize, int cycles, int extraDegree, int bridges,
+                                           const GeneratorOptions& options = {}, const EdgeSink& sink = {});
+
+    // union of degree / 2 random Hamiltonian cycles on n vertices, a regular multigraph whose min cut is its degree
+    GeneratedGraph generateRandomRegular(int n, int degree, const GeneratorOptions& options = {}, const EdgeSink& sink = {});
+
+    // two RMAT halves of 2^scale vertices and edgeFactor * 2^scale edges each, over `cycles` Hamiltonian
+    // cycles per half, joined by `bridges` unit edges (bridges <= 2 * cycles); min cut = bridges
+    GeneratedGraph generateRmat(int scale, int edgeFactor, int cycles, int bridges,
+                                const GeneratorOptions& options = {}, const EdgeSink& sink = {});
+
+    // rows x cols grid (min cut 2, or 1 for a path) or torus (min cut 4), every edge sharing one weight
+    GeneratedGraph generateGrid(int rows, int cols, bool torus, const GeneratorOptions& options = {}, const EdgeSink& sink = {});
+
+    // Edge list input
+    // text format: "n m" followed by m pairs "u v", whitespace separated, ids in [0, n); '#' and '%' start
+    // comments that run to the end of the line
+    // malformed input throws std::runtime_error; threads = 0 means one per hardware thread
+    struct EdgeList {
+        int n = 0;
+        std::vector<Edge> edges;
+    };
+
+    EdgeList parseEdgeList(const char* data, std::size_t size, int threads = 0);
+
+    // memory-maps regular files, reads pipes in large blocks
+    EdgeList readEdgeList(int fd, int threads = 0);
+    EdgeList readEdgeList(const std::string& path, int threads = 0);
+
+    // Sparse vertex ids
+    // engines index vertices 0..n-1; graphs keyed by arbitrary 64-bit ids (hashes, database keys) are
+    // densified first. Dense ids follow the sorted order of the external ids, so the mapping is the same for
+    // any thread count. Only ids that appear in some edge get a dense id.
+    struct ExternalEdge { std::uint64_t u, v; };
+
+    struct RemappedGraph;
+
+    // open-addressing hash map from external ids to dense ids, plus the reverse table
+    class VertexIdMap {
+    public:
+        int n() const { return static_cast<int>(ids_.size()); }
+        int dense(std::uint64_t id) const; // -1 when the id never appeared
+        std::uint64_t external(int v) const { return ids_[v]; }
+        ExternalEdge external(Edge e) const { return {ids_[e.u], ids_[e.v]}; }
+
+        // external ids of the vertices with side[v] == which, for partitions such as GeneratedGraph::side
+        std::vector<std::uint64_t> externalSide(std::span<const std::uint8_t> side, std::uint8_t which) const;
+        // cut edges (or any dense edges) translated back
+        std::vector<ExternalEdge> externalEdges(std::span<const Edge> edges) const;
+
+    private:
+        friend RemappedGraph remapVertexIds(std::span<const ExternalEdge> edges, int threads);
+
+        struct Slot {
+            std::uint64_t key; // UINT64_MAX marks a free slot
+            int value;
+        };
+        std::vector<std::uint64_t> ids_; // dense -> external, ascending
+        std::vector<Slot> slots_;        // linear probing, key and dense id side by side for one cache miss per lookup
+        std::uint64_t mask_ = 0;
+        int emptyKeyValue_ = -1;         // dense id of the external id UINT64_MAX, -1 when absent
+    };
+
+    struct RemappedGraph {
+        int n = 0;
+        std::vector<Edge> edges;
+        VertexIdMap ids;
+    };
+
+    // threads = 0 means one per hardware thread; more than INT_MAX distinct ids throws std::length_error
+    RemappedGraph remapVertexIds(std::span<const ExternalEdge> edges, int threads = 0);
+
+    // text format: "m" followed by m pairs "u v" of unsigned 64-bit ids, errors as for readEdgeList
+    std::vector<ExternalEdge> parseSparseEdgeList(const char* data, std::size_t size, int threads = 0);
+    std::vector<ExternalEdge> readSparseEdgeList(int fd, int threads = 0);
+    std::vector<ExternalEdge> readSparseEdgeList(const std::string& path, int threads = 0);
+
+    // Binary graph files
+    // mappable edge list (plus optional degree and CSR tables), layout documented in binary_graph.cpp;
+    // I/O errors and corrupt files throw std::runtime_error
+    enum class WeightType : std::uint32_t { None = 0, Int32 = 1 };
+
+    struct BinaryGraphOptions {
+        bool degrees = false; // per-vertex endpoint counts
+        bool csr = false;     // offsets + adjacency, every edge listed from both ends
+        const std::int32_t* weights = nullptr; // m per-edge weights, stored as WeightType::Int32
+    };
+
+    // ids outside [0, n) throw std::invalid_argument before anything is written
+    void writeBinaryGraph(const std::string& path, int n, std::span<const Edge> edges, const BinaryGraphOptions& options = {});
+
+    // converts the "n m, then pairs" text format
+    void convertEdgeListToBinary(const std::string& textPath, const std::string& binaryPath,
+                                 const BinaryGraphOptions& options = {}, int threads = 0);
+
+    // true when the file starts with the binary graph magic
+    bool isBinaryGraph(const std::string& path);
+
+    // writes a binary graph file (edges only) from chunks of unknown total, e.g. a generator's EdgeSink,
+    // without holding the edges in memory. finish(n) writes the header, so a stream that is never
+    // finished leaves a file without the magic; ids outside [0, n) throw std::invalid_argument there.
+    class BinaryGraphStream {
+    public:
+        explicit BinaryGraphStream(const std::string& path);
+        BinaryGraphStream(const BinaryGraphStream&) = delete;
+        BinaryGraphStream& operator=(const BinaryGraphStream&) = delete;
+        ~BinaryGraphStream();
+
+        void write(const Edge* edges, std::size_t count);
+        EdgeSink sink() { return [this](const Edge* edges, std::size_t count) { write(edges, count); }; }
+        void finish(int n);
+
+    private:
+        std::string path_;
+        std::FILE* file_ = nullptr;
+        std::size_t m_ = 0;
+        int lowest_ = 0, highest_ = -1; // min(0, smallest id written) and max(-1, largest id written)
+    };
+
+    // read-only shared mapping of a binary graph file, every accessor points straight into the mapping;
+    // the constructor validates sections, ids and degree/CSR tables in one O(n + m) pass
+    class MappedGraph {
+    public:
+        explicit MappedGraph(const std::string& path);
+        MappedGraph(MappedGraph&& other) noexcept;
+        MappedGraph& operator=(MappedGraph&& other) noexcept;
+        MappedGraph(const MappedGraph&) = delete;
+        MappedGraph& operator=(const MappedGraph&) = delete;
+        ~MappedGraph();
+
+        int n() const { return n_; }
+        std::size_t m() const { return m_; }
+        std::span<const Edge> edges() const { return {edges_, m_}; }
+        const std::int32_t* weights() const { return weights_; }     // nullptr when unweighted
+        const std::uint32_t* degrees() const { return degrees_; }    // nullptr when absent
+        const std::uint64_t* offsets() const { return offsets_; }    // n + 1 entries, nullptr when absent
+        const std::int32_t* adjacency() const { return adjacency_; } // 2m entries, nullptr when absent
+
+    private:
+        const char* base_ = nullptr;
+        std::size_t size_ = 0;
+        int n_ = 0;
+        std::size_t m_ = 0;
+        const Edge* edges_ = nullptr;
+        const std::int32_t* weights_ = nullptr;
+        const std::uint32_t* degrees_ = nullptr;
+        const std::uint64_t* offsets_ = nullptr;
+        const std::int32_t* adjacency_ = nullptr;
+    };
 }
 
 #endif
@@ -0,0 +1,32 @@
+/* Converter
+Turns a "n m, then m pairs" text edge list into a binary graph file (binary_graph.cpp).
+  karger_convert [--degrees] [--csr] input.txt output.kg
+*/
+
+#include "karger.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    karger::BinaryGraphOptions options;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--degrees") options.degrees = true;
+        else if (arg == "--csr") options.csr = true;
+        else paths.push_back(arg);
+    }
+    if (paths.size() != 2) {
+        std::cerr << "usage: karger_convert [--degrees] [--csr] input.txt output.kg\n";
+        return 2;
+    }
+
+    try {
+        karger::convertEdgeListToBinary(paths[0], paths[1], options);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* Karger-Stein recursive contraction
+Plain Karger contraction is most likely to destroy the min cut in its last few contractions, so
+Karger-Stein contracts down to about n / sqrt(2) supernodes only once and then branches twice on the
+rest. One run succeeds with probability Omega(1 / log n) instead of Omega(1 / n^2) for O(n^2 log n) work.
+
+Contracting uniformly random edges until t supernodes remain is the same as running the disjoint set
+over a random permutation of the edges, so each level shuffles, contracts, and keeps only the edges
+that still cross before recursing on the smaller graph.
+The whole recursion shares one RollbackUnionFind over the original vertices: a branch contracts on top
+of its parent's state and rolls back when it returns, so no level allocates or copies per-vertex arrays
+and the edges carry root ids instead of being relabelled. Branches of 6 supernodes or fewer are
+finished exactly with the bitmask engine.
+Every level is a template over the index type, int or std::int64_t.
+*/
+
+#include "karger.hpp"
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace karger {
+
+namespace {
+
+// the supernodes of a finished branch are union-find roots with arbitrary ids; renumber them 0..k-1 in
+// place for the bitmask engine
+template <class Index>
+void relabelSmall(std::vector<BasicEdge<Index>>& edges) {
+    std::array<Index, 6> roots;
+    std::size_t k = 0;
+    auto label = [&](Index r) {
+        for (std::size_t i = 0; i < k; ++i) {
+            if (roots[i] == r) return static_cast<Index>(i);
+        }
+        roots[k] = r;
+        return static_cast<Index>(k++);
+    };
+    for (auto& e : edges) e = {label(e.u), label(e.v)};
+}
+
+// `edges` join roots of uf (self-loops are dropped on the way down) and there are `supernodes` of them. Each branch contracts a fresh
+// random order down to the target on top of the shared union-find, recurses on the edges that still
+// cross (rewritten to their roots, in their incoming order) and rolls back before the next branch.
+template <class Index>
+Index recurse(RollbackUnionFind<Index>& uf, Index supernodes, std::span<const BasicEdge<Index>> edges,
+              std::mt19937_64& rng) {
+    Index target = static_cast<Index>(std::ceil(1.0 + supernodes / std::sqrt(2.0)));
+    Index best = std::numeric_limits<Index>::max();
+    std::vector<BasicEdge<Index>> crossing;
+    for (int branch = 0; branch < 2; ++branch) {
+        std::size_t mark = uf.checkpoint();
+
+        // contracting uniformly random edges is the disjoint set over a shuffled copy
+        crossing.assign(edges.begin(), edges.end());
+        std::shuffle(crossing.begin(), crossing.end(), rng);
+        Index left = supernodes;
+        for (const auto& e : crossing) {
+            if (left <= target) break;
+            if (uf.unite(e.u, e.v)) --left;
+        }
+
+        crossing.clear();
+        for (const auto& e : edges) {
+            Index a = uf.find(e.u);
+            Index b = uf.find(e.v);
+            if (a != b) crossing.push_back({a, b});
+        }
+
+        if (left <= 6) {
+            relabelSmall(crossing);
+            best = std::min(best, minCutBitmask(left, crossing));
+        } else {
+            best = std::min(best, recurse<Index>(uf, left, crossing, rng));
+        }
+        uf.rollback(mark);
+    }
+    return best;
+}
+
+template <class Index>
+Index kargerStein(Index n, std::span<const BasicEdge<Index>> edges, std::uint64_t seed) {
+    if (n <= 1 || edges.empty()) return 0;
+
+    // the recursion assumes every level can reach its target, which needs a connected graph
+    RollbackUnionFind<Index> uf(n);
+    for (const auto& e : edges) uf.unite(e.u, e.v);
+    if (uf.components() > 1) return 0;
+    uf.rollback(0);
+
+    if (n <= 6) return minCutBitmask(n, edges);
+
+    std::mt19937_64 rng(seed);
+    return recurse<Index>(uf, n, edges, rng);
+}
+
+}
+
+int minCutKargerStein(int n, std::span<const Edge> edges, std::uint64_t seed) {
+    return kargerStein(n, detail::intEdges(edges), seed);
+}
+
+std::int64_t minCutKargerStein(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed) {
+    return kargerStein(n, edges, seed);
+}
+
+}
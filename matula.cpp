@@ -0,0 +1,66 @@
+/* Matula's (2 + eps)-approximation
+Every supernode's degree is a cut, so the smallest one, U, bounds lambda from above. Let K = ceil(U / (2 + eps)).
+A maximum adjacency scan numbers the copies of each pair r + 1 .. r + w as it crosses them (r = how much of
+the far vertex's adjacency was scanned before), and a pair holding a copy numbered K or more has local
+connectivity at least K (Nagamochi-Ibaraki). Contracting all those pairs:
+
+- if lambda < K, no min cut separates them, so the contracted graph keeps lambda;
+- if lambda >= K, then U <= (2 + eps) K <= (2 + eps) lambda already.
+
+Either way the smallest supernode degree seen over all rounds ends within 2 + eps of lambda. The vertex
+scanned last reaches its whole degree, at least U >= K, so every round contracts something, and Matula
+shows a constant fraction of the edges (depending on eps) goes each round, O(m / eps) in total.
+
+Each round is one contractConnectedPairs (max_adjacency.hpp): a scan with keys capped at K and a counting
+sort rebuild, both linear in the pairs left.
+*/
+
+#include "karger.hpp"
+#include "max_adjacency.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+template <class Index>
+Index matula(Index n, std::span<const BasicEdge<Index>> edges, double eps) {
+    if (!(eps > 0.0)) throw std::invalid_argument("minCutApproxMatula needs eps > 0");
+    if (n <= 1) return 0;
+
+    using Weight = std::uint64_t;
+    auto pairs = detail::collapseParallelEdges<Weight>(edges);
+    Index vertices = n;
+    Weight best = std::numeric_limits<Weight>::max();
+
+    std::vector<Weight> degree;
+    std::vector<Index> label;
+    while (vertices > 1) {
+        degree.assign(vertices, 0);
+        for (const auto& [a, b, w] : pairs) {
+            degree[a] += w;
+            degree[b] += w;
+        }
+        Weight smallest = *std::min_element(degree.begin(), degree.end());
+        best = std::min(best, smallest);
+        if (best == 0) return 0;
+
+        Weight k = static_cast<Weight>(std::ceil(static_cast<double>(best) / (2.0 + eps)));
+        vertices = detail::contractConnectedPairs(vertices, pairs, k, label);
+    }
+    return static_cast<Index>(best);
+}
+
+}
+
+int minCutApproxMatula(int n, std::span<const Edge> edges, double eps) {
+    return matula(n, detail::intEdges(edges), eps);
+}
+
+std::int64_t minCutApproxMatula(std::int64_t n, std::span<const Edge64> edges, double eps) {
+    return matula(n, edges, eps);
+}
+
+}
@@ -0,0 +1,106 @@
+#ifndef KARGER_MAX_ADJACENCY_HPP
+#define KARGER_MAX_ADJACENCY_HPP
+
+// Internal helper shared by Matula's approximation and the cut sparsifier, not part of the public API.
+//
+// A maximum adjacency scan numbers the copies of each pair r + 1 .. r + w as it crosses them (r = how much
+// of the far vertex's adjacency was scanned before), and a pair holding a copy numbered k or more has local
+// connectivity at least k (Nagamochi-Ibaraki). One round contracts all those pairs. The scan only needs
+// keys up to k, so its queue is an array of k + 1 buckets with lazy entries and a pointer that only falls
+// when a bucket runs dry, and the contracted graph is rebuilt with a counting sort: linear in the pairs.
+
+#include "karger.hpp"
+#include "pair_weights.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace karger::detail {
+
+// contracts every pair of the `vertices`-vertex graph whose copies reach k and rebuilds `pairs` over the
+// supernodes, merging parallel pairs. label[v] becomes v's supernode; returns how many supernodes remain.
+// If some vertex has degree k or more, at least one pair is contracted.
+template <class Index, class Weight>
+Index contractConnectedPairs(Index vertices, std::vector<WeightedPair<Index, Weight>>& pairs, Weight k,
+                             std::vector<Index>& label) {
+    std::vector<std::vector<std::pair<Index, Weight>>> adj(vertices);
+    for (const auto& [a, b, w] : pairs) {
+        adj[a].push_back({b, w});
+        adj[b].push_back({a, w});
+    }
+
+    // maximum adjacency scan with keys capped at k, uniting every pair that reaches k
+    UnionFind<Index> uf(vertices);
+    std::vector<Weight> reached(vertices, 0);
+    std::vector<char> scanned(vertices, 0);
+    std::vector<std::vector<Index>> bucket(k + 1);
+    for (Index v = vertices; v-- > 0;) bucket[0].push_back(v);
+    Weight top = 0;
+    for (Index step = 0; step < vertices; ++step) {
+        Index pick = -1;
+        for (;;) {
+            while (bucket[top].empty()) --top; // never runs dry below 0 while vertices are unscanned
+            Index v = bucket[top].back();
+            bucket[top].pop_back();
+            if (!scanned[v] && reached[v] == top) {
+                pick = v;
+                break;
+            }
+        }
+        scanned[pick] = 1;
+        for (const auto& [y, w] : adj[pick]) {
+            if (scanned[y] || reached[y] == k) {
+                if (!scanned[y]) uf.unite(pick, y);
+                continue;
+            }
+            Weight r = std::min(k, reached[y] + w);
+            if (r == k) uf.unite(pick, y);
+            reached[y] = r;
+            bucket[r].push_back(y);
+            top = std::max(top, r);
+        }
+    }
+
+    // the contracted graph as collapsed pairs over new ids
+    label.assign(vertices, -1);
+    Index next = 0;
+    for (Index v = 0; v < vertices; ++v) {
+        Index r = uf.find(v);
+        if (label[r] == -1) label[r] = next++;
+    }
+    for (Index v = 0; v < vertices; ++v) label[v] = label[uf.find(v)];
+    // counting sort by lower endpoint, then a stamp per upper endpoint merges parallel pairs in O(m + n)
+    std::vector<std::size_t> begin(static_cast<std::size_t>(next) + 1, 0);
+    std::vector<WeightedPair<Index, Weight>> grouped;
+    for (auto& p : pairs) {
+        Index x = label[p.a], y = label[p.b];
+        p.a = std::min(x, y);
+        p.b = std::max(x, y);
+        if (x != y) ++begin[p.a + 1];
+    }
+    for (Index v = 0; v < next; ++v) begin[v + 1] += begin[v];
+    grouped.resize(begin[next]);
+    std::vector<std::size_t> fill(begin.begin(), begin.end() - 1);
+    for (const auto& p : pairs) {
+        if (p.a != p.b) grouped[fill[p.a]++] = p;
+    }
+    std::vector<Index> stamp(next, -1);
+    std::vector<std::size_t> slot(next);
+    pairs.clear();
+    for (Index a = 0; a < next; ++a) {
+        for (std::size_t i = begin[a]; i < begin[a + 1]; ++i) {
+            const auto& p = grouped[i];
+            if (stamp[p.b] == a) {
+                pairs[slot[p.b]].weight += p.weight;
+            } else {
+                stamp[p.b] = a;
+                slot[p.b] = pairs.size();
+                pairs.push_back(p);
+            }
+        }
+    }
+    return next;
+}
+
+}
+
+#endif
@@ -0,0 +1,318 @@
+/* Dispatcher
+karger::minCut looks at the shape of the graph (n, m, density, parallel edge multiplicity, connectivity)
+and the guarantee the caller asked for, estimates the cost of every engine that can honour that
+guarantee, and runs the cheapest one.
+
+- Exact: bitmask enumeration, dense Stoer-Wagner, sparse Stoer-Wagner or Hao-Orlin. Hao-Orlin's single
+  push-relabel run beats sparse Stoer-Wagner by one to two orders of magnitude on the bench graphs, so it
+  takes the sparse work unless options.haoOrlin is off.
+- MonteCarlo: any exact engine, or enough repeated Karger / Karger-Stein runs to push the chance of
+  missing the min cut below options.errorProbability.
+- Heuristic: degree-biased contraction while it fits options.degreeBiasedBudget, otherwise the fixed
+  permutation contraction, or an exact engine when that is no more expensive.
+- Approximate: any exact engine, or Stoer-Wagner on a uniform sample of the edges (Karger's skeleton).
+  Keeping each edge with probability p >= rho / lambda, rho = 3 (ln(1 / errorProbability) + 2 ln n) /
+  delta^2, keeps every cut within 1 +- delta of p times its value. The sample's best partition is then
+  within (1 + delta) / (1 - delta) of lambda, so delta = epsilon / 3 makes that at most 1 + epsilon. The
+  rate starts from the min degree (an upper bound on lambda), and since the sample's min cut is about
+  p lambda, a sample whose min cut falls short of rho / (1 + delta)^2 shows the rate was too low: it is
+  raised by that shortfall and the sample redrawn, reaching the exact engine at p = 1 in the worst case.
+  Every sampled partition is valued on the original edges and the best is returned, so the answer is
+  always a real cut.
+
+The cost model is deliberately crude (operation counts, no constants), the thresholds live in
+MinCutOptions and the decision plus timings come back in MinCutReport so they can be tuned per machine.
+Both index widths share one templated dispatcher. The connectivity check unites edge chunks on
+options.threads threads through ConcurrentUnionFind.
+*/
+
+#include "karger.hpp"
+#include "pair_weights.hpp"
+#include "parallel.hpp"
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+constexpr std::size_t kMinChunkEdges = std::size_t{1} << 16; // below this a thread costs more than it saves
+
+// fills distinctPairs, maxMultiplicity, minDegree and connected
+template <class Index>
+void analyse(Index n, std::span<const BasicEdge<Index>> edges, int threads, MinCutReport& report) {
+    // components: chunks of edges united concurrently, each chunk counting its own successful unions
+    std::size_t chunks = std::min<std::size_t>(detail::resolveThreads(threads), edges.size() / kMinChunkEdges + 1);
+    ConcurrentUnionFind<Index> uf(n);
+    std::vector<Index> unions(chunks, 0);
+    detail::parallelFor(chunks, threads, [&](std::size_t k) {
+        std::size_t begin = edges.size() * k / chunks, end = edges.size() * (k + 1) / chunks;
+        Index count = 0;
+        for (std::size_t i = begin; i < end; ++i) count += uf.unite(edges[i].u, edges[i].v);
+        unions[k] = count;
+    });
+    Index components = n;
+    for (Index u : unions) components -= u;
+
+    std::vector<std::size_t> degree(n, 0);
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        ++degree[e.u];
+        ++degree[e.v];
+    }
+    report.minDegree = n > 0 ? *std::min_element(degree.begin(), degree.end()) : 0;
+
+    std::size_t distinct = 0, maxMultiplicity = 0;
+    for (const auto& pair : detail::collapseParallelEdges<std::size_t>(edges)) {
+        ++distinct;
+        maxMultiplicity = std::max(maxMultiplicity, pair.weight);
+    }
+
+    double pairs = 0.5 * static_cast<double>(n) * (n - 1.0);
+    report.distinctPairs = distinct;
+    report.maxMultiplicity = maxMultiplicity;
+    report.density = pairs > 0 ? distinct / pairs : 0.0;
+    report.connected = (components == 1);
+}
+
+// the degree-biased engine takes 32-bit ids only; it is never picked for a graph too big to narrow
+int degreeBiased(int n, std::span<const Edge> edges) {
+    return deterministic_degree_biased_karger(n, edges);
+}
+
+std::int64_t degreeBiased(std::int64_t n, std::span<const Edge64> edges) {
+    std::vector<Edge> narrow;
+    narrow.reserve(edges.size());
+    for (const auto& e : edges) narrow.push_back({static_cast<int>(e.u), static_cast<int>(e.v)});
+    return deterministic_degree_biased_karger(static_cast<int>(n), narrow);
+}
+
+// the skeleton's own accuracy: cuts within 1 +- epsilon / 3 put the best sampled partition within 1 + epsilon
+double skeletonDelta(const MinCutOptions& options) {
+    return options.epsilon / 3.0;
+}
+
+// edges kept per unit of min cut for a (1 +- skeletonDelta) skeleton
+double skeletonRho(double n, const MinCutOptions& options) {
+    double failure = std::clamp(options.errorProbability, 1e-300, 0.999);
+    double delta = skeletonDelta(options);
+    return 3.0 * (std::log(1.0 / failure) + 2.0 * std::log(std::max(n, 2.0))) / (delta * delta);
+}
+
+struct Candidate {
+    Engine engine;
+    double cost;
+    std::size_t trials;
+};
+
+// estimated operation counts for each engine, infinity when the engine is ruled out
+std::vector<Candidate> candidates(const MinCutReport& r, const MinCutOptions& options) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double n = static_cast<double>(r.n);
+    const double m = static_cast<double>(r.m);
+    const double d = 2.0 * static_cast<double>(r.distinctPairs);
+    const double logN = std::log2(n + 1.0);
+
+    double bitmask = (r.n <= std::min(options.bitmaskMaxVertices, 30)) ? std::ldexp(n, static_cast<int>(r.n) - 1) : inf;
+    double dense = (r.n <= options.denseMaxVertices) ? n * n * n : inf;
+    double sparse = n * (d + n) * std::log2(d + 2.0);
+    double flow = options.haoOrlin ? n * (d + n) * std::log2(n * n / (d + n) + 2.0) : inf;
+
+    switch (options.guarantee) {
+    case Guarantee::Exact:
+        return {{Engine::Bitmask, bitmask, 1}, {Engine::StoerWagnerDense, dense, 1}, {Engine::StoerWagner, sparse, 1},
+                {Engine::HaoOrlin, flow, 1}};
+    case Guarantee::MonteCarlo: {
+        double delta = std::clamp(options.errorProbability, 1e-300, 0.999);
+        double lnInv = std::log(1.0 / delta);
+        // one Karger trial finds a fixed min cut with probability >= 2 / (n (n - 1))
+        double kargerTrials = std::ceil(0.5 * n * (n - 1.0) * lnInv);
+        // one Karger-Stein run succeeds with probability >= 1 / (log2 n + 1)
+        double steinTrials = std::ceil((logN + 1.0) * lnInv);
+        return {{Engine::Bitmask, bitmask, 1}, {Engine::StoerWagnerDense, dense, 1}, {Engine::StoerWagner, sparse, 1},
+                {Engine::HaoOrlin, flow, 1},
+                {Engine::Randomised, kargerTrials * (m + n), static_cast<std::size_t>(kargerTrials)},
+                {Engine::KargerStein, steinTrials * (m + n * n) * logN, static_cast<std::size_t>(steinTrials)}};
+    }
+    case Guarantee::Heuristic: {
+        // degree-biased rescans every edge (plus a BFS for single edges) for each of its n contractions,
+        // but it is the better heuristic so it wins whenever it fits the budget
+        double degreeBiased = n * m * (n + m);
+        double fixed = (m + n) * std::log2(m + 2.0);
+        if (degreeBiased > options.degreeBiasedBudget) degreeBiased = inf;
+        else fixed = inf;
+        return {{Engine::Bitmask, bitmask, 1}, {Engine::DegreeBiased, degreeBiased, 1}, {Engine::FixedPermutation, fixed, 1}};
+    }
+    case Guarantee::Approximate: {
+        // one sample at the starting rate, later rounds only happen when the min degree overestimates lambda
+        double rate = std::min(1.0, skeletonRho(n, options) / std::max<double>(static_cast<double>(r.minDegree), 1.0));
+        double sampled = m + n * (rate * d + n) * std::log2(rate * d + 2.0);
+        if (rate >= 1.0) sampled = inf; // nothing to gain over the plain engine
+        return {{Engine::Bitmask, bitmask, 1}, {Engine::StoerWagnerDense, dense, 1}, {Engine::StoerWagner, sparse, 1},
+                {Engine::HaoOrlin, flow, 1}, {Engine::SampledStoerWagner, sampled, 1}};
+    }
+    }
+    return {};
+}
+
+}
+
+const char* engineName(Engine engine) {
+    switch (engine) {
+    case Engine::Trivial: return "trivial";
+    case Engine::Bitmask: return "bitmask";
+    case Engine::StoerWagnerDense: return "stoer-wagner-dense";
+    case Engine::StoerWagner: return "stoer-wagner";
+    case Engine::Randomised: return "randomised";
+    case Engine::KargerStein: return "karger-stein";
+    case Engine::FixedPermutation: return "fixed-permutation";
+    case Engine::DegreeBiased: return "degree-biased";
+    case Engine::SampledStoerWagner: return "sampled-stoer-wagner";
+    case Engine::HaoOrlin: return "hao-orlin";
+    }
+    return "unknown";
+}
+
+namespace {
+
+// Approximate route: Stoer-Wagner on samples at a rate adapted to the cut, see the file comment
+template <class Index>
+Index sampledStoerWagner(Index n, std::span<const BasicEdge<Index>> edges, const MinCutOptions& options, MinCutReport& r) {
+    double rho = skeletonRho(static_cast<double>(n), options);
+    double delta = skeletonDelta(options);
+    double rate = std::min(1.0, rho / std::max<double>(static_cast<double>(r.minDegree), 1.0));
+    Index best = static_cast<Index>(r.minDegree);
+    std::vector<BasicEdge<Index>> sample;
+    for (std::size_t round = 0;; ++round) {
+        r.trials = round + 1;
+        if (rate >= 1.0) {
+            best = std::min(best, minCutStoerWagner(n, edges));
+            if (options.observer) options.observer->onTrialComplete(round, best);
+            return best;
+        }
+
+        std::mt19937_64 rng(options.seed + round);
+        std::geometric_distribution<std::size_t> gap(rate);
+        sample.clear();
+        for (std::size_t i = gap(rng); i < edges.size(); i += 1 + gap(rng)) sample.push_back(edges[i]);
+
+        BasicKCut<Index> cut = minCutStoerWagnerPartition(n, std::span<const BasicEdge<Index>>(sample));
+        Index value = 0;
+        for (const auto& e : edges) value += cut.part[e.u] != cut.part[e.v];
+        best = std::min(best, value);
+        if (options.observer) options.observer->onTrialComplete(round, value);
+
+        // enough of the min cut survived to trust the sample
+        double shortfall = rho / ((1.0 + delta) * (1.0 + delta) * std::max<double>(static_cast<double>(cut.value), 1.0));
+        if (shortfall <= 1.0) return best;
+        rate = std::min(1.0, rate * shortfall);
+    }
+}
+
+template <class Index>
+Index dispatch(Index n, std::span<const BasicEdge<Index>> edges, const MinCutOptions& options, MinCutReport* report) {
+    if (options.guarantee == Guarantee::Approximate && !(options.epsilon > 0.0 && options.epsilon <= 1.0)) {
+        throw std::invalid_argument("minCut needs 0 < epsilon <= 1 for Guarantee::Approximate");
+    }
+    auto start = Clock::now();
+    MinCutReport local;
+    MinCutReport& r = report ? *report : local;
+    r = MinCutReport{};
+    r.n = n;
+    r.m = edges.size();
+
+    // nothing to decide for empty or disconnected graphs
+    if (n <= 1 || edges.empty()) {
+        r.connected = (n <= 1);
+        r.analyseSeconds = secondsSince(start);
+        if (options.observer) options.observer->onResult(0);
+        return 0;
+    }
+    analyse(n, edges, options.threads, r);
+    r.analyseSeconds = secondsSince(start);
+    if (!r.connected) {
+        if (options.observer) options.observer->onResult(0);
+        return 0;
+    }
+
+    // pick the cheapest candidate
+    Candidate best{Engine::Trivial, std::numeric_limits<double>::infinity(), 0};
+    for (const auto& c : candidates(r, options)) {
+        if (c.cost < best.cost) best = c;
+    }
+    r.engine = best.engine;
+    r.estimatedCost = best.cost;
+    r.trials = best.trials;
+
+    auto solveStart = Clock::now();
+    Index cut = 0;
+    switch (best.engine) {
+    case Engine::Trivial:
+        break;
+    case Engine::Bitmask:
+        cut = minCutBitmask(n, edges);
+        break;
+    case Engine::StoerWagnerDense:
+        cut = minCutStoerWagnerDense(n, edges);
+        break;
+    case Engine::StoerWagner:
+        cut = minCutStoerWagner(n, edges);
+        break;
+    case Engine::Randomised:
+        cut = std::numeric_limits<Index>::max();
+        for (std::size_t t = 0; t < best.trials; ++t) {
+            Index trial = minCutRandomised(n, edges, options.seed + t);
+            if (options.observer) options.observer->onTrialComplete(t, trial);
+            cut = std::min(cut, trial);
+        }
+        break;
+    case Engine::KargerStein:
+        cut = std::numeric_limits<Index>::max();
+        for (std::size_t t = 0; t < best.trials; ++t) {
+            Index trial = minCutKargerStein(n, edges, options.seed + t);
+            if (options.observer) options.observer->onTrialComplete(t, trial);
+            cut = std::min(cut, trial);
+        }
+        break;
+    case Engine::FixedPermutation:
+        cut = minCutFixedPermutation(n, edges);
+        break;
+    case Engine::DegreeBiased:
+        cut = degreeBiased(n, edges);
+        break;
+    case Engine::SampledStoerWagner:
+        cut = sampledStoerWagner(n, edges, options, r);
+        break;
+    case Engine::HaoOrlin:
+        cut = minCutHaoOrlin(n, edges);
+        break;
+    }
+    r.solveSeconds = secondsSince(solveStart);
+
+    if (options.observer) {
+        if (best.trials <= 1 && best.engine != Engine::SampledStoerWagner) options.observer->onTrialComplete(0, cut);
+        options.observer->onResult(cut);
+    }
+    return cut;
+}
+
+}
+
+int minCut(int n, std::span<const Edge> edges, const MinCutOptions& options, MinCutReport* report) {
+    return dispatch(n, detail::intEdges(edges), options, report);
+}
+
+std::int64_t minCut(std::int64_t n, std::span<const Edge64> edges, const MinCutOptions& options, MinCutReport* report) {
+    return dispatch(n, edges, options, report);
+}
+
+}
@@ -0,0 +1,450 @@
+/* All minimum cuts as a cactus
+A connected graph has at most n (n - 1) / 2 minimum cuts, and they fit in a cactus with O(n) nodes and
+edges (Dinits, Karzanov and Lomonosov): every min cut is one tree edge or two edges of one cycle.
+
+The construction is exact and follows Karzanov and Timofeev. Number the vertices v1 = 0, v2, ..., vn in
+breadth-first order, so each vi has a neighbour in Xi = {v1, ..., vi-1}. Sorting every min cut by the
+first vi it puts away from vertex 0 splits the cuts into classes Ci: the min cuts with Xi on one side and
+vi on the other. Two cuts of Ci cannot cross, since crossing min cuts leave no edge between their common
+part and the outside and vi has an edge into Xi, so Ci is a chain. It comes out of one max flow from Xi
+into vi, given up once it passes lambda: at exactly lambda the cuts are the residual-closed sets, which
+here are the strongly connected components of the residual graph added one at a time in the order
+Tarjan's algorithm finishes them. That labels every vertex with a level 0..k, level 0 staying with Xi
+and level k holding vi.
+
+The cactus then grows backwards from a single node holding every vertex: stage i turns the cactus of
+G / Xi+1 into that of G / Xi by splitting vi out of the root node along the chain of Ci. Levels are
+pieces of cycles where two neighbouring levels are each a min cut and so is their union (the edges between
+them weigh lambda / 2); a level that is a min cut on its own, holding a single node, is a cycle of three.
+The other levels become a path of nodes from the root to vi's node, joined by tree edges or, across each
+run of pieces, closed into a cycle. What hung off the root (subtrees and cycles, each on a single level,
+or the pieces of a cycle the previous stage collapsed) is hung back on the node of its level. Nothing but
+the cactus itself, the residual network and O(n) labels per stage is ever held, so the cuts are never
+listed.
+*/
+
+#include "karger.hpp"
+#include "pair_weights.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+// the collapsed graph as a residual network, for max flows from a set of sources into one sink
+template <class Index>
+class Network {
+public:
+    Network(Index n, std::span<const BasicEdge<Index>> edges)
+        : n_(n), first_(static_cast<std::size_t>(n) + 1, 0), dist_(n), cur_(n), order_(n), low_(n), onStack_(n) {
+        auto pairs = detail::collapseParallelEdges<long long>(edges);
+        for (const auto& p : pairs) {
+            ++first_[p.a + 1];
+            ++first_[p.b + 1];
+        }
+        for (Index v = 0; v < n; ++v) first_[v + 1] += first_[v];
+        head_.resize(first_[n]);
+        rev_.resize(first_[n]);
+        cap_.resize(first_[n]);
+        std::vector<std::size_t> fill(first_.begin(), first_.end() - 1);
+        for (const auto& p : pairs) {
+            std::size_t i = fill[p.a]++, j = fill[p.b]++;
+            head_[i] = p.b;
+            head_[j] = p.a;
+            rev_[i] = j;
+            rev_[j] = i;
+            cap_[i] = p.weight;
+            cap_[j] = p.weight;
+        }
+    }
+
+    // Dinic from `sources` into `sink`, given up once the flow reaches `limit`
+    long long maxFlow(std::span<const Index> sources, Index sink, long long limit) {
+        res_ = cap_;
+        sink_ = sink;
+        long long total = 0;
+        while (total < limit && layer(sources)) {
+            for (Index v = 0; v < n_; ++v) cur_[v] = first_[v];
+            for (Index s : sources) {
+                total += augment(s, limit - total);
+                if (total == limit) break;
+            }
+        }
+        return total;
+    }
+
+    // after a max flow of lambda, the chain of min cuts as levels: 0 for what the sources reach, 1.. for
+    // the components of the rest in Tarjan's finishing order, the last level for what reaches the sink.
+    // Returns the last level.
+    Index chain(std::span<const Index> sources, std::vector<Index>& level) {
+        constexpr Index kFree = -1, kSink = -2;
+        level.assign(n_, kFree);
+        std::vector<Index> queue(sources.begin(), sources.end());
+        for (Index s : sources) level[s] = 0;
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            Index x = queue[q];
+            for (std::size_t i = first_[x]; i < first_[x + 1]; ++i) {
+                if (res_[i] > 0 && level[head_[i]] == kFree) {
+                    level[head_[i]] = 0;
+                    queue.push_back(head_[i]);
+                }
+            }
+        }
+        queue.assign(1, sink_);
+        level[sink_] = kSink;
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            Index y = queue[q];
+            for (std::size_t i = first_[y]; i < first_[y + 1]; ++i) {
+                if (res_[rev_[i]] > 0 && level[head_[i]] == kFree) {
+                    level[head_[i]] = kSink;
+                    queue.push_back(head_[i]);
+                }
+            }
+        }
+
+        // Tarjan over the free vertices; a component is finished only after every one it reaches
+        Index counter = 0, components = 0;
+        std::fill(order_.begin(), order_.end(), -1);
+        std::vector<Index> stack;
+        std::vector<std::pair<Index, std::size_t>> calls;
+        for (Index root = 0; root < n_; ++root) {
+            if (level[root] != kFree || order_[root] != -1) continue;
+            order_[root] = low_[root] = counter++;
+            stack.push_back(root);
+            onStack_[root] = 1;
+            calls.push_back({root, first_[root]});
+            while (!calls.empty()) {
+                auto [x, i] = calls.back();
+                if (i < first_[x + 1]) {
+                    ++calls.back().second;
+                    Index y = head_[i];
+                    if (res_[i] == 0 || level[y] != kFree) continue;
+                    if (order_[y] == -1) {
+                        order_[y] = low_[y] = counter++;
+                        stack.push_back(y);
+                        onStack_[y] = 1;
+                        calls.push_back({y, first_[y]});
+                    } else if (onStack_[y]) {
+                        low_[x] = std::min(low_[x], order_[y]);
+                    }
+                    continue;
+                }
+                calls.pop_back();
+                if (!calls.empty()) low_[calls.back().first] = std::min(low_[calls.back().first], low_[x]);
+                if (low_[x] != order_[x]) continue;
+                ++components;
+                Index y;
+                do {
+                    y = stack.back();
+                    stack.pop_back();
+                    onStack_[y] = 0;
+                    level[y] = components;
+                } while (y != x);
+            }
+        }
+        for (Index v = 0; v < n_; ++v) {
+            if (level[v] == kSink) level[v] = components + 1;
+        }
+        return components + 1;
+    }
+
+private:
+    // breadth-first distances from the sources over residual arcs; false once the sink is out of reach
+    bool layer(std::span<const Index> sources) {
+        std::fill(dist_.begin(), dist_.end(), -1);
+        std::vector<Index> queue(sources.begin(), sources.end());
+        for (Index s : sources) dist_[s] = 0;
+        for (std::size_t q = 0; q < queue.size() && dist_[sink_] == -1; ++q) {
+            Index x = queue[q];
+            for (std::size_t i = first_[x]; i < first_[x + 1]; ++i) {
+                if (res_[i] > 0 && dist_[head_[i]] == -1) {
+                    dist_[head_[i]] = dist_[x] + 1;
+                    queue.push_back(head_[i]);
+                }
+            }
+        }
+        return dist_[sink_] != -1;
+    }
+
+    // a blocking flow out of s, at most `want`, walking the layers with an explicit path of arcs
+    long long augment(Index s, long long want) {
+        long long pushed = 0;
+        path_.clear();
+        Index x = s;
+        while (pushed < want) {
+            if (x == sink_) {
+                long long f = want - pushed;
+                for (std::size_t i : path_) f = std::min(f, res_[i]);
+                for (std::size_t i : path_) {
+                    res_[i] -= f;
+                    res_[rev_[i]] += f;
+                }
+                pushed += f;
+                std::size_t keep = 0;
+                while (keep < path_.size() && res_[path_[keep]] > 0) ++keep;
+                path_.resize(keep);
+                x = keep ? head_[path_.back()] : s;
+                continue;
+            }
+            std::size_t& i = cur_[x];
+            while (i < first_[x + 1] && (res_[i] == 0 || dist_[head_[i]] != dist_[x] + 1)) ++i;
+            if (i < first_[x + 1]) {
+                path_.push_back(i);
+                x = head_[i];
+                continue;
+            }
+            // dead end: x drops out of this layering
+            if (path_.empty()) break;
+            dist_[x] = -1;
+            path_.pop_back();
+            x = path_.empty() ? s : head_[path_.back()];
+        }
+        return pushed;
+    }
+
+    Index n_;
+    std::vector<std::size_t> first_, rev_;
+    std::vector<Index> head_;
+    std::vector<long long> cap_, res_;
+    Index sink_ = 0;
+    std::vector<Index> dist_;
+    std::vector<std::size_t> cur_, path_;
+    std::vector<Index> order_, low_;
+    std::vector<char> onStack_;
+};
+
+// the cactus being grown, rooted at node 0 (which always holds vertex 0)
+template <class Index>
+class Growth {
+public:
+    explicit Growth(Index n) : node_(n, 0) { newNode(0); }
+
+    // splits `vertex` out of the root along its chain: level[v] for every vertex and k the last level;
+    // alone[j] says level j by itself is a min cut, linked[j] that levels j and j + 1 together are one
+    void split(Index vertex, const std::vector<Index>& level, Index k, const std::vector<char>& alone,
+               const std::vector<char>& linked) {
+        auto fail = [] { throw std::logic_error("minCutCactus: chain does not match the cactus"); };
+
+        // what hangs off the root, by level: subtrees and cycles on one level move as they are, cycles
+        // spread over several levels are the chain's own, collapsed when vertex was merged into the root
+        std::vector<Index> trees = std::move(trees_[0]);
+        std::vector<std::size_t> hung = std::move(hung_[0]);
+        trees_[0].clear();
+        hung_[0].clear();
+        std::vector<Index> piece(k + 1, -1), singles(k + 1, 0), wholes(k + 1, 0);
+        for (Index x : trees) {
+            Index j = level[rep_[x]];
+            ++singles[j];
+            piece[j] = x;
+        }
+        std::vector<std::size_t> whole;
+        std::vector<Index> loose;
+        for (std::size_t c : hung) {
+            std::vector<Index>& ring = rings_[c];
+            Index j = level[rep_[ring[1]]];
+            bool spread = false;
+            for (std::size_t p = 2; p < ring.size(); ++p) spread = spread || level[rep_[ring[p]]] != j;
+            if (!spread) {
+                ++wholes[j];
+                whole.push_back(c);
+                continue;
+            }
+            for (std::size_t p = 1; p < ring.size(); ++p) {
+                ++singles[level[rep_[ring[p]]]];
+                piece[level[rep_[ring[p]]]] = ring[p];
+                loose.push_back(ring[p]);
+            }
+            ring.clear();
+            spare_.push_back(c);
+        }
+
+        // the levels that are pieces of the chain's cycles: runs of linked levels, and a lone level holding
+        // a single node when neither neighbour is a piece. That makes a cycle of three rather than an empty
+        // node with three tree edges, which a later stage would take for one subtree across two levels.
+        std::vector<char> cycle(k + 2, 0);
+        for (Index j = 1; j < k; ++j) cycle[j] = linked[j - 1] || linked[j];
+        for (Index j = 1; j < k; ++j) {
+            if (alone[j] && !cycle[j - 1] && !cycle[j] && !cycle[j + 1] && singles[j] == 1 && wholes[j] == 0) cycle[j] = 1;
+        }
+
+        std::vector<Index> spine(k + 1, -1);
+        spine[0] = 0;
+        for (Index j = 1; j <= k; ++j) {
+            if (!cycle[j]) spine[j] = newNode(vertex);
+            else if (singles[j] != 1 || wholes[j] != 0) fail();
+        }
+        for (std::size_t v = 0; v < node_.size(); ++v) {
+            if (node_[v] != 0) continue;
+            if (cycle[level[v]]) fail();
+            node_[v] = spine[level[v]];
+        }
+        for (Index x : trees) {
+            Index j = level[rep_[x]];
+            if (!cycle[j]) trees_[spine[j]].push_back(x);
+        }
+        for (std::size_t c : whole) {
+            Index j = level[rep_[rings_[c][1]]];
+            if (cycle[j]) fail();
+            rings_[c][0] = spine[j];
+            hung_[spine[j]].push_back(c);
+        }
+        for (Index x : loose) {
+            if (!cycle[level[rep_[x]]]) fail();
+        }
+
+        for (Index j = 0; j < k;) {
+            if (!cycle[j + 1]) {
+                trees_[spine[j]].push_back(spine[j + 1]);
+                ++j;
+                continue;
+            }
+            std::vector<Index> ring{spine[j]};
+            Index q = j + 1;
+            for (; cycle[q]; ++q) ring.push_back(piece[q]);
+            ring.push_back(spine[q]);
+            hung_[spine[j]].push_back(newRing(std::move(ring)));
+            j = q;
+        }
+    }
+
+    void finish(BasicCactus<Index>& out) {
+        out.nodes = static_cast<Index>(trees_.size());
+        out.node = std::move(node_);
+        for (Index x = 0; x < out.nodes; ++x) {
+            for (Index y : trees_[x]) out.treeEdges.push_back({x, y});
+        }
+        for (auto& ring : rings_) {
+            if (!ring.empty()) out.cycles.push_back(std::move(ring));
+        }
+    }
+
+private:
+    // rep is any vertex below the node, which stays below it for good
+    Index newNode(Index rep) {
+        trees_.emplace_back();
+        hung_.emplace_back();
+        rep_.push_back(rep);
+        return static_cast<Index>(trees_.size() - 1);
+    }
+
+    std::size_t newRing(std::vector<Index>&& ring) {
+        if (spare_.empty()) {
+            rings_.push_back(std::move(ring));
+            return rings_.size() - 1;
+        }
+        std::size_t c = spare_.back();
+        spare_.pop_back();
+        rings_[c] = std::move(ring);
+        return c;
+    }
+
+    std::vector<Index> node_;
+    std::vector<std::vector<Index>> trees_;     // per node, its children by tree edges
+    std::vector<std::vector<std::size_t>> hung_; // per node, the cycles whose first node it is
+    std::vector<Index> rep_;
+    std::vector<std::vector<Index>> rings_;     // the node nearest the root first, then around the cycle
+    std::vector<std::size_t> spare_;
+};
+
+template <class Index>
+BasicCactus<Index> cactus(Index n, std::span<const BasicEdge<Index>> edges) {
+    BasicCactus<Index> out;
+    out.node.assign(n, 0);
+    if (n <= 1) {
+        out.nodes = n;
+        return out;
+    }
+
+    // disconnected: one node per component, no edges
+    UnionFind<Index> components(n);
+    for (const auto& e : edges) components.unite(e.u, e.v);
+    if (components.components() > 1) {
+        std::vector<Index> label(n, -1);
+        for (Index v = 0; v < n; ++v) {
+            Index r = components.find(v);
+            if (label[r] == -1) label[r] = out.nodes++;
+            out.node[v] = label[r];
+        }
+        return out;
+    }
+
+    // breadth-first order from vertex 0
+    std::vector<std::size_t> first(static_cast<std::size_t>(n) + 1, 0);
+    for (const auto& e : edges) {
+        ++first[e.u + 1];
+        ++first[e.v + 1];
+    }
+    for (Index v = 0; v < n; ++v) first[v + 1] += first[v];
+    std::vector<Index> adjacent(first[n]);
+    std::vector<std::size_t> fill(first.begin(), first.end() - 1);
+    for (const auto& e : edges) {
+        adjacent[fill[e.u]++] = e.v;
+        adjacent[fill[e.v]++] = e.u;
+    }
+    std::vector<Index> order{0};
+    std::vector<char> queued(n, 0);
+    queued[0] = 1;
+    for (std::size_t q = 0; q < order.size(); ++q) {
+        for (std::size_t i = first[order[q]]; i < first[order[q] + 1]; ++i) {
+            if (!queued[adjacent[i]]) {
+                queued[adjacent[i]] = 1;
+                order.push_back(adjacent[i]);
+            }
+        }
+    }
+    std::vector<std::size_t>().swap(first);
+    std::vector<Index>().swap(adjacent);
+
+    out.minCut = minCutHaoOrlin(n, edges);
+    long long lambda = out.minCut;
+    Network<Index> network(n, edges);
+    Growth<Index> growth(n);
+    std::vector<Index> level;
+    std::vector<long long> cut, between;
+    std::vector<char> alone, linked;
+    for (Index i = n - 1; i >= 1; --i) {
+        std::span<const Index> sources(order.data(), static_cast<std::size_t>(i));
+        if (network.maxFlow(sources, order[i], lambda + 1) > lambda) continue;
+
+        Index k = network.chain(sources, level);
+        cut.assign(static_cast<std::size_t>(k) + 1, 0);
+        between.assign(static_cast<std::size_t>(k) + 1, 0);
+        for (const auto& e : edges) {
+            Index a = std::min(level[e.u], level[e.v]), b = std::max(level[e.u], level[e.v]);
+            if (a == b) continue;
+            ++cut[a];
+            ++cut[b];
+            if (b == a + 1) ++between[a];
+        }
+        alone.assign(static_cast<std::size_t>(k) + 1, 0);
+        linked.assign(static_cast<std::size_t>(k) + 1, 0);
+        for (Index j = 1; j < k; ++j) alone[j] = cut[j] == lambda;
+        for (Index j = 1; j + 1 < k; ++j) linked[j] = alone[j] && alone[j + 1] && 2 * between[j] == lambda;
+        growth.split(order[i], level, k, alone, linked);
+    }
+    growth.finish(out);
+    return out;
+}
+
+}
+
+template <class Index>
+std::size_t BasicCactus<Index>::cutCount() const {
+    std::size_t count = treeEdges.size();
+    for (const auto& cycle : cycles) count += cycle.size() * (cycle.size() - 1) / 2;
+    return count;
+}
+
+template struct BasicCactus<int>;
+template struct BasicCactus<std::int64_t>;
+
+Cactus minCutCactus(int n, std::span<const Edge> edges) {
+    return cactus(n, detail::intEdges(edges));
+}
+
+Cactus64 minCutCactus(std::int64_t n, std::span<const Edge64> edges) {
+    return cactus(n, edges);
+}
+
+}
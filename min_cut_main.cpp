@@ -0,0 +1,725 @@
+/* Dispatcher driver
+Reads "n m" followed by m edge pairs from stdin, or a text or binary graph file given with --input,
+and prints the min cut plus the dispatcher's report. With --sparse-ids the text input is "m" followed by
+m pairs of arbitrary 64-bit ids, densified with karger::remapVertexIds before solving.
+  min_cut [--exact | --monte-carlo [errorProbability] | --heuristic | --approximate [epsilon]] [--sparse-ids]
+          [--input path]
+  min_cut --test
+*/
+
+#include "karger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <string>
+
+namespace {
+
+void printReport(const karger::MinCutReport& r) {
+    std::cout << "engine: " << karger::engineName(r.engine) << "\n"
+              << "n: " << r.n << ", m: " << r.m << ", distinct pairs: " << r.distinctPairs
+              << ", max multiplicity: " << r.maxMultiplicity << ", density: " << r.density
+              << ", connected: " << (r.connected ? "yes" : "no") << "\n"
+              << "trials: " << r.trials << ", estimated cost: " << r.estimatedCost << "\n"
+              << "analyse: " << r.analyseSeconds << "s, solve: " << r.solveSeconds << "s\n";
+}
+
+int solve(int n, std::span<const karger::Edge> edges, const karger::MinCutOptions& options) {
+    karger::MinCutReport report;
+    int cut = karger::minCut(n, edges, options, &report);
+    std::cout << cut << "\n";
+    printReport(report);
+    return 0;
+}
+
+int runCli(const karger::MinCutOptions& options, const std::string& path, bool sparseIds) {
+    try {
+        if (sparseIds) {
+            auto external = path.empty() ? karger::readSparseEdgeList(0) : karger::readSparseEdgeList(path);
+            karger::RemappedGraph graph = karger::remapVertexIds(external);
+            return solve(graph.n, graph.edges, options);
+        }
+        if (!path.empty() && karger::isBinaryGraph(path)) {
+            karger::MappedGraph graph(path); // engines read the mapping directly
+            return solve(graph.n(), graph.edges(), options);
+        }
+        karger::EdgeList input = path.empty() ? karger::readEdgeList(0) : karger::readEdgeList(path); // 0 = stdin
+        return solve(input.n, input.edges, options);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
+
+// exact and Monte Carlo answers must match the known min cut
+bool runTests() {
+    std::cout << "Dispatcher tests\n";
+
+    struct TestCase {
+        std::string name;
+        int n;
+        std::vector<karger::Edge> edges;
+        int expected;
+    };
+
+    std::vector<TestCase> tests = {
+        {"triangle", 3, {{0,1},{1,2},{0,2}}, 2},
+        {"two triangles + single bridge", 6, {{0,1},{1,2},{0,2},{3,4},{4,5},{3,5},{2,3}}, 1},
+        {"two triangles + double bridge", 6, {{0,1},{1,2},{0,2},{3,4},{4,5},{3,5},{2,3},{2,3}}, 2},
+        {"complete K5", 5, {{0,1},{0,2},{0,3},{0,4},{1,2},{1,3},{1,4},{2,3},{2,4},{3,4}}, 4},
+        {"square + parallel edge", 4, {{0,1},{1,2},{2,3},{3,0},{0,1}}, 2},
+        {"triangle + self-loop", 3, {{0,1},{1,2},{0,2},{1,1}}, 2},
+        {"disconnected (one edge only)", 5, {{0,1}}, 0},
+        {"empty graph", 4, {}, 0},
+        {"dual-path bottleneck", 8, {{0,1},{1,0},{2,3},{3,2},{0,4},{4,5},{5,2},{1,6},{6,7},{7,3}}, 2},
+    };
+
+    // generated graphs with a min cut known by construction
+    auto addGenerated = [&tests](const std::string& name, const karger::GeneratedGraph& g) {
+        tests.push_back({name, g.n, g.edges, g.minCut});
+    };
+    karger::GeneratorOptions weighted;
+    weighted.maxWeight = 3;
+    addGenerated("generated planted clusters", karger::generatePlantedClusters(3, 12, 2, 2, 3));
+    addGenerated("generated random 4-regular", karger::generateRandomRegular(20, 4));
+    addGenerated("generated weighted torus", karger::generateGrid(4, 6, true, weighted));
+
+    // force every exact engine plus the Monte Carlo route
+    std::vector<karger::MinCutOptions> configs(5);
+    configs[1].bitmaskMaxVertices = 0;
+    configs[2].bitmaskMaxVertices = 0;
+    configs[2].denseMaxVertices = 0;
+    configs[2].haoOrlin = false;
+    configs[3].guarantee = karger::Guarantee::MonteCarlo;
+    configs[3].bitmaskMaxVertices = 0;
+    configs[3].denseMaxVertices = 0;
+    configs[3].haoOrlin = false;
+    configs[4].bitmaskMaxVertices = 0;
+    configs[4].denseMaxVertices = 0;
+
+    int failcount = 0;
+
+    // generator sizes whose vertex count or min cut does not fit in int are rejected, not wrapped
+    {
+        karger::GeneratorOptions heavy;
+        heavy.maxWeight = std::numeric_limits<int>::max();
+        std::vector<std::pair<std::string, std::function<void()>>> oversized = {
+            {"planted clusters", [] { karger::generatePlantedClusters(70000, 70000, 1, 0, 1); }},
+            {"grid", [] { karger::generateGrid(50000, 50000, false); }},
+            {"weighted regular", [&heavy] { karger::generateRandomRegular(3, 200, heavy); }},
+        };
+        for (const auto& [name, generate] : oversized) {
+            bool threw = false;
+            try {
+                generate();
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            if (!threw) ++failcount;
+            std::cout << "[" << (threw ? "PASS" : "FAIL") << "] oversized " << name << " rejected (generators)\n";
+        }
+    }
+
+    for (const auto& test : tests) {
+        for (const auto& options : configs) {
+            karger::MinCutReport report;
+            int cut = karger::minCut(test.n, test.edges, options, &report);
+            bool passed = (cut == test.expected);
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (" << karger::engineName(report.engine)
+                      << ") expected " << test.expected << ", got " << cut << "\n";
+        }
+    }
+
+    // the same graphs widened to 64-bit indices must give the same answers on every route
+    for (const auto& test : tests) {
+        std::vector<karger::Edge64> wide;
+        for (const auto& e : test.edges) wide.push_back({e.u, e.v});
+        for (const auto& options : configs) {
+            karger::MinCutReport report;
+            std::int64_t cut = karger::minCut(std::int64_t{test.n}, wide, options, &report);
+            bool passed = (cut == test.expected);
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (64-bit, " << karger::engineName(report.engine)
+                      << ") expected " << test.expected << ", got " << cut << "\n";
+        }
+    }
+
+    // the same graphs again over scattered 64-bit ids, densified by remapVertexIds
+    std::vector<karger::ExternalEdge> external;
+    for (const auto& test : tests) {
+        std::vector<std::uint64_t> scatter(test.n);
+        for (int v = 0; v < test.n; ++v) scatter[v] = (0x9e3779b97f4a7c15ull * (v + 1)) ^ (v % 2 ? ~0ull : 0ull);
+        if (test.n > 0) scatter[0] = ~0ull; // the id the hash table uses as its empty marker
+        external.clear();
+        for (const auto& e : test.edges) external.push_back({scatter[e.u], scatter[e.v]});
+        karger::RemappedGraph graph = karger::remapVertexIds(external, 2);
+        bool mapsBack = true;
+        for (std::size_t i = 0; i < external.size(); ++i) {
+            karger::ExternalEdge back = graph.ids.external(graph.edges[i]);
+            mapsBack = mapsBack && back.u == external[i].u && back.v == external[i].v &&
+                       graph.ids.dense(external[i].u) == graph.edges[i].u;
+        }
+        // vertices without edges get no dense id, so graphs with isolated vertices are left out
+        if (graph.n != test.n) continue;
+        int cut = karger::minCut(graph.n, graph.edges);
+        bool passed = mapsBack && cut == test.expected;
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (sparse ids) expected " << test.expected
+                  << ", got " << cut << (mapsBack ? "" : ", ids do not map back") << "\n";
+    }
+
+    // the text parser: comments, blank lines and CRLF are skipped, anything malformed or a body that does
+    // not hold exactly m edges throws
+    {
+        auto parse = [](const std::string& text, int threads, karger::EdgeList& out) {
+            try {
+                out = karger::parseEdgeList(text.data(), text.size(), threads);
+                return true;
+            } catch (const std::runtime_error&) {
+                return false;
+            }
+        };
+        struct TextCase {
+            std::string name, text;
+            bool valid;
+            std::vector<karger::Edge> edges;
+        };
+        std::vector<TextCase> textTests = {
+            {"comments and blank lines", "# SNAP banner\n% matrix market\n\n4 3 # n m\n\n0 1\n# between edges\n1 2\n\n2 3 % trailing\n",
+             true, {{0,1},{1,2},{2,3}}},
+            {"CRLF line ends", "3 2\r\n0 1\r\n1 2\r\n", true, {{0,1},{1,2}}},
+            {"no final newline", "3 2\n0 1\n1 2", true, {{0,1},{1,2}}},
+            {"letter in an id", "3 2\n0 1\n1 x\n", false, {}},
+            {"id glued to a comment", "3 2\n0 1\n1 2#x\n", false, {}},
+            {"negative id", "3 2\n0 1\n1 -2\n", false, {}},
+            {"id out of range", "3 2\n0 1\n1 3\n", false, {}},
+            {"fewer edges than m", "3 2\n0 1\n", false, {}},
+            {"more edges than m", "3 1\n0 1\n1 2\n", false, {}},
+            {"half an edge", "3 2\n0 1\n1\n", false, {}},
+            {"missing header", "# nothing else\n", false, {}},
+            {"negative n", "-1 0\n", false, {}},
+        };
+        for (const auto& test : textTests) {
+            karger::EdgeList parsed;
+            bool valid = parse(test.text, 1, parsed);
+            bool same = !valid || (parsed.edges.size() == test.edges.size() &&
+                                   std::equal(parsed.edges.begin(), parsed.edges.end(), test.edges.begin(),
+                                              [](const karger::Edge& a, const karger::Edge& b) { return a.u == b.u && a.v == b.v; }));
+            bool passed = valid == test.valid && same;
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (edge list text)\n";
+        }
+
+        // a body of several MB splits into chunks; shifting it by a few bytes moves every boundary across
+        // numbers and comments, and every split must give the single-threaded edges. The body without
+        // comments takes the chunks' fast token count.
+        std::mt19937_64 rng(9);
+        const int n = 1000000;
+        std::vector<karger::Edge> edges(400000);
+        std::string body, plain;
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            edges[i] = {static_cast<int>(rng() % n), static_cast<int>(rng() % n)};
+            std::string line = std::to_string(edges[i].u) + (i % 7 ? " " : " \t ") + std::to_string(edges[i].v) + "\n";
+            body += line;
+            plain += line;
+            if (i % 1000 == 0) body += "# checkpoint " + std::to_string(i) + "\n";
+        }
+        bool passed = true;
+        for (const std::string* text : {&body, &plain}) {
+            for (int shift = 0; shift < 8; ++shift) {
+                std::string full = std::to_string(n) + " " + std::to_string(edges.size()) + std::string(shift + 1, ' ') + "\n" + *text;
+                karger::EdgeList parsed;
+                passed = passed && parse(full, 4, parsed) && parsed.n == n && parsed.edges.size() == edges.size() &&
+                         std::equal(parsed.edges.begin(), parsed.edges.end(), edges.begin(),
+                                    [](const karger::Edge& a, const karger::Edge& b) { return a.u == b.u && a.v == b.v; });
+            }
+        }
+        for (std::size_t m : {edges.size() - 1, edges.size() + 1}) {
+            std::string text = std::to_string(n) + " " + std::to_string(m) + "\n" + body;
+            karger::EdgeList parsed;
+            passed = passed && !parse(text, 4, parsed);
+        }
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] chunked parse (edge list text)\n";
+    }
+
+    // binary graph files: a write -> MappedGraph round trip with and without the optional sections, and
+    // truncated or corrupt files rejected with std::runtime_error. Section offsets sit at byte 40 + 8 * k of
+    // the header (edges, weights, degrees, offsets, adjacency), m at byte 24.
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "karger_min_cut_test.bin").string();
+        auto slurp = [&path]() {
+            std::ifstream in(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), {});
+        };
+        auto spill = [&path](const std::string& bytes) {
+            std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        };
+        auto word = [](const std::string& bytes, std::size_t at) {
+            std::uint64_t value = 0;
+            std::memcpy(&value, bytes.data() + at, sizeof value);
+            return value;
+        };
+        auto rejects = [&path]() {
+            try {
+                karger::MappedGraph graph(path);
+                return false;
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+        };
+
+        const TestCase& source = tests.back();
+        std::vector<std::int32_t> weights(source.edges.size());
+        for (std::size_t i = 0; i < weights.size(); ++i) weights[i] = static_cast<std::int32_t>(i % 7) + 1;
+        karger::BinaryGraphOptions full;
+        full.degrees = true;
+        full.csr = true;
+        full.weights = weights.data();
+        for (const auto& options : {karger::BinaryGraphOptions{}, full}) {
+            karger::writeBinaryGraph(path, source.n, source.edges, options);
+            karger::MappedGraph graph(path);
+            bool passed = karger::isBinaryGraph(path) && graph.n() == source.n && graph.m() == source.edges.size() &&
+                          std::equal(source.edges.begin(), source.edges.end(), graph.edges().begin(),
+                                     [](const karger::Edge& a, const karger::Edge& b) { return a.u == b.u && a.v == b.v; }) &&
+                          karger::minCut(graph.n(), graph.edges()) == source.expected;
+            bool extras = options.weights != nullptr;
+            passed = passed && (graph.weights() != nullptr) == extras && (graph.degrees() != nullptr) == extras &&
+                     (graph.offsets() != nullptr) == extras && (graph.adjacency() != nullptr) == extras;
+            if (passed && extras) {
+                passed = std::equal(weights.begin(), weights.end(), graph.weights()) && graph.offsets()[graph.n()] == 2 * graph.m();
+                for (int v = 0; v < graph.n(); ++v) {
+                    passed = passed && graph.offsets()[v + 1] - graph.offsets()[v] == graph.degrees()[v];
+                }
+            }
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] round trip" << (extras ? " with weights, degrees and CSR" : "")
+                      << " (binary graph)\n";
+        }
+
+        // every corruption starts again from the full file
+        const std::string good = slurp();
+
+        // ids outside [0, n) are refused before the file is touched, with or without the CSR tables
+        for (const auto& options : {karger::BinaryGraphOptions{}, full}) {
+            for (karger::Edge bad : {karger::Edge{0, source.n}, karger::Edge{-1, 0}}) {
+                std::vector<karger::Edge> edges = source.edges;
+                edges.back() = bad;
+                bool threw = false;
+                try {
+                    karger::writeBinaryGraph(path, source.n, edges, options);
+                } catch (const std::invalid_argument&) {
+                    threw = true;
+                }
+                bool passed = threw && slurp() == good;
+                if (!passed) ++failcount;
+                std::cout << "[" << (passed ? "PASS" : "FAIL") << "] write with id " << (bad.u < 0 ? bad.u : bad.v)
+                          << (options.csr ? " and CSR" : "") << " rejected (binary graph)\n";
+            }
+        }
+        struct Corruption {
+            std::string name;
+            std::function<void(std::string&)> apply;
+        };
+        auto patch32 = [](std::string& bytes, std::uint64_t at, std::int32_t value) { std::memcpy(&bytes[at], &value, sizeof value); };
+        auto patch64 = [](std::string& bytes, std::uint64_t at, std::uint64_t value) { std::memcpy(&bytes[at], &value, sizeof value); };
+        std::vector<Corruption> corruptions = {
+            {"truncated", [](std::string& bytes) { bytes.resize(bytes.size() / 2); }},
+            {"header only", [](std::string& bytes) { bytes.resize(40); }},
+            {"bad magic", [](std::string& bytes) { bytes[0] = 'X'; }},
+            {"m wrapping the size check", [&](std::string& bytes) { patch64(bytes, 24, std::uint64_t{1} << 61); }},
+            {"m past the file", [&](std::string& bytes) { patch64(bytes, 24, bytes.size()); }},
+            {"unaligned section", [&](std::string& bytes) { patch64(bytes, 40, word(bytes, 40) + 8); }},
+            {"endpoint equal to n", [&](std::string& bytes) { patch32(bytes, word(bytes, 40) + 4, source.n); }},
+            {"negative endpoint", [&](std::string& bytes) { patch32(bytes, word(bytes, 40), -1); }},
+            {"wrong degree", [&](std::string& bytes) { patch32(bytes, word(bytes, 56), 1000); }},
+            {"CSR offsets not spanning", [&](std::string& bytes) { patch64(bytes, word(bytes, 64) + 8 * source.n, 1); }},
+            {"CSR id outside n", [&](std::string& bytes) { patch32(bytes, word(bytes, 72), source.n + 5); }},
+            {"CSR without offsets", [&](std::string& bytes) { patch64(bytes, 64, 0); }},
+        };
+        for (const auto& corruption : corruptions) {
+            std::string bytes = good;
+            corruption.apply(bytes);
+            spill(bytes);
+            bool passed = rejects();
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << corruption.name << " rejected (binary graph)\n";
+        }
+
+        // a generator streamed to disk maps back to the graph it builds in memory; an unfinished stream
+        // is not a binary graph, and finishing with ids past n throws
+        {
+            karger::GeneratorOptions options;
+            options.maxWeight = 3;
+            karger::GeneratedGraph memory = karger::generatePlantedClusters(4, 50, 2, 6, 2, options);
+            karger::GeneratedGraph streamed;
+            bool unfinished = false;
+            {
+                karger::BinaryGraphStream stream(path);
+                streamed = karger::generatePlantedClusters(4, 50, 2, 6, 2, options, stream.sink());
+                unfinished = !karger::isBinaryGraph(path);
+                stream.finish(streamed.n);
+            }
+            karger::MappedGraph graph(path);
+            bool passed = unfinished && graph.n() == memory.n && graph.m() == memory.edges.size() &&
+                          std::equal(memory.edges.begin(), memory.edges.end(), graph.edges().begin(),
+                                     [](const karger::Edge& a, const karger::Edge& b) { return a.u == b.u && a.v == b.v; }) &&
+                          karger::minCut(graph.n(), graph.edges()) == memory.minCut;
+            bool threw = false;
+            try {
+                karger::BinaryGraphStream stream(path);
+                stream.sink()(memory.edges.data(), memory.edges.size());
+                stream.finish(memory.n - 1);
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            passed = passed && threw;
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] generator streamed to disk (binary graph)\n";
+        }
+        std::filesystem::remove(path);
+    }
+
+    // the best of 300 parallel Karger trials on two threads finds the min cut of the small graphs
+    for (const auto& test : tests) {
+        if (test.n > 8) continue;
+        int best = std::numeric_limits<int>::max();
+        for (std::uint64_t seed = 0; seed < 300; ++seed) best = std::min(best, karger::minCutRandomisedParallel(test.n, test.edges, seed, 2));
+        bool passed = (best == test.expected);
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (parallel randomised) expected " << test.expected
+                  << ", got " << best << "\n";
+    }
+
+    // 3-cuts of the small graphs against brute force over every labelling; both variants must return a
+    // genuine 3-partition whose value matches its crossing edges
+    for (const auto& test : tests) {
+        if (test.n < 3 || test.n > 8) continue;
+        auto crossing = [&test](const std::vector<int>& part) {
+            int value = 0;
+            for (const auto& e : test.edges) value += part[e.u] != part[e.v];
+            return value;
+        };
+        int exact = std::numeric_limits<int>::max();
+        std::vector<int> part(test.n, 0);
+        for (int code = 0, total = static_cast<int>(std::pow(3, test.n)); code < total; ++code) {
+            std::vector<bool> used(3, false);
+            for (int v = 0, c = code; v < test.n; ++v, c /= 3) used[part[v] = c % 3] = true;
+            if (used[0] && used[1] && used[2]) exact = std::min(exact, crossing(part));
+        }
+        karger::KCut repeated = karger::minKCut(test.n, test.edges, 3, 500, 1);
+        karger::KCut recursive{std::numeric_limits<int>::max(), {}};
+        for (std::uint64_t seed = 0; seed < 20; ++seed) {
+            karger::KCut run = karger::minKCutRecursive(test.n, test.edges, 3, seed);
+            if (run.value < recursive.value) recursive = run;
+        }
+        bool passed = true;
+        for (const auto* cut : {&repeated, &recursive}) {
+            int parts = 1 + *std::max_element(cut->part.begin(), cut->part.end());
+            passed = passed && cut->value == exact && crossing(cut->part) == exact && parts == 3;
+        }
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (3-cut) expected " << exact << ", got "
+                  << repeated.value << " / " << recursive.value << "\n";
+    }
+
+    // every level of both dendrograms must match replaying its first n - k merges, and level 2 is the engine's cut
+    for (const auto& test : tests) {
+        std::pair<karger::Dendrogram, int> runs[] = {
+            {karger::contractionDendrogramRandomised(test.n, test.edges, 7), karger::minCutRandomised(test.n, test.edges, 7)},
+            {karger::contractionDendrogramFixedPermutation(test.n, test.edges), karger::minCutFixedPermutation(test.n, test.edges)},
+        };
+        bool passed = true;
+        for (const auto& [dendrogram, cut] : runs) {
+            if (dendrogram.minSupernodes() == 2) passed = passed && dendrogram.cutAt(2) == cut;
+            for (int k = test.n; k >= dendrogram.minSupernodes(); --k) {
+                karger::UnionFind<int> replay(test.n);
+                for (int i = 0; i < test.n - k; ++i) replay.unite(dendrogram.merges()[i].a, dendrogram.merges()[i].b);
+                int crossing = 0;
+                for (const auto& e : test.edges) crossing += !replay.same(e.u, e.v);
+                passed = passed && replay.components() == k && dendrogram.cutAt(k) == crossing;
+                for (int v = 0; v < test.n; ++v) {
+                    auto members = dendrogram.members(v, k);
+                    int size = 0;
+                    for (int w = 0; w < test.n; ++w) size += replay.same(v, w);
+                    passed = passed && static_cast<int>(members.size()) == size &&
+                             replay.same(v, dendrogram.supernode(v, k));
+                    for (int w : members) passed = passed && replay.same(v, w);
+                }
+            }
+        }
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (dendrogram)\n";
+    }
+
+    // the cactus must give exactly the brute-force min cuts: removing one tree edge or two edges of one
+    // cycle, the vertices on nodes cut off from vertex 0's node; plus a ring and a path, which have many,
+    // and a square whose vertices 2 and 3 are consecutive single-vertex cuts of one chain but not a cycle
+    std::vector<TestCase> cactusTests = tests;
+    cactusTests.push_back({"ring of 10", 10, {}, 2});
+    for (int v = 0; v < 10; ++v) cactusTests.back().edges.push_back({v, (v + 1) % 10});
+    cactusTests.push_back({"path of 7", 7, {{0,1},{1,2},{2,3},{3,4},{4,5},{5,6}}, 1});
+    cactusTests.push_back({"ring of triangles", 9, {{0,1},{1,2},{0,2},{3,4},{4,5},{3,5},{6,7},{7,8},{6,8},{2,3},{5,6},{8,0}}, 2});
+    cactusTests.push_back({"square with diagonals", 4, {{0,1},{1,2},{1,2},{2,3},{3,0},{3,0},{0,2},{1,3}}, 4});
+    for (const auto& test : cactusTests) {
+        if (test.n < 2 || test.n > 12 || test.expected == 0) continue;
+        std::vector<unsigned> exact;
+        for (unsigned mask = 2; mask < (1u << test.n); mask += 2) {
+            int value = 0;
+            for (const auto& e : test.edges) value += ((mask >> e.u) & 1u) != ((mask >> e.v) & 1u);
+            if (value == test.expected) exact.push_back(mask);
+        }
+
+        karger::Cactus cactus = karger::minCutCactus(test.n, test.edges);
+        std::vector<karger::Edge> links = cactus.treeEdges;
+        for (const auto& cycle : cactus.cycles) {
+            for (std::size_t i = 0; i < cycle.size(); ++i) links.push_back({cycle[i], cycle[(i + 1) % cycle.size()]});
+        }
+        auto side = [&](std::size_t skipA, std::size_t skipB) {
+            karger::UnionFind<int> joined(cactus.nodes);
+            for (std::size_t i = 0; i < links.size(); ++i) {
+                if (i != skipA && i != skipB) joined.unite(links[i].u, links[i].v);
+            }
+            unsigned mask = 0;
+            for (int v = 0; v < test.n; ++v) mask |= unsigned{!joined.same(cactus.node[v], cactus.node[0])} << v;
+            return mask;
+        };
+        std::vector<unsigned> found;
+        for (std::size_t i = 0; i < cactus.treeEdges.size(); ++i) found.push_back(side(i, i));
+        for (std::size_t first = cactus.treeEdges.size(); const auto& cycle : cactus.cycles) {
+            for (std::size_t i = 0; i < cycle.size(); ++i) {
+                for (std::size_t j = i + 1; j < cycle.size(); ++j) found.push_back(side(first + i, first + j));
+            }
+            first += cycle.size();
+        }
+        std::sort(found.begin(), found.end());
+        bool passed = cactus.minCut == test.expected && found == exact && cactus.cutCount() == exact.size();
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (cactus) expected " << exact.size()
+                  << " min cuts, got " << found.size() << "\n";
+    }
+    {
+        // too many cuts to list: a ring of 800 is one cycle through every vertex
+        std::vector<karger::Edge> ring;
+        for (int v = 0; v < 800; ++v) ring.push_back({v, (v + 1) % 800});
+        karger::Cactus cactus = karger::minCutCactus(800, ring);
+        bool passed = cactus.minCut == 2 && cactus.nodes == 800 && cactus.treeEdges.empty() && cactus.cycles.size() == 1 &&
+                      cactus.cutCount() == 800 * 799 / 2;
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] ring of 800 (cactus) expected " << 800 * 799 / 2
+                  << " min cuts, got " << cactus.cutCount() << "\n";
+    }
+
+    // cuts within 1.5x of the minimum, streamed with the guaranteed trial count, against brute force
+    for (const auto& test : cactusTests) {
+        if (test.n < 2 || test.n > 10) continue;
+        std::vector<std::pair<unsigned, int>> exact, found;
+        for (unsigned mask = 2; mask < (1u << test.n); mask += 2) {
+            int value = 0;
+            for (const auto& e : test.edges) value += ((mask >> e.u) & 1u) != ((mask >> e.v) & 1u);
+            if (value <= 1.5 * test.expected) exact.push_back({mask, value});
+        }
+        bool passed = true;
+        std::size_t streamed = karger::enumerateNearMinCuts(test.n, test.edges, 1.5, karger::nearMinCutTrials(test.n, 1.5, 1e-6), 5,
+                                                            [&](int value, std::span<const int> side) {
+            unsigned mask = 0;
+            for (int v : side) mask |= 1u << v;
+            passed = passed && std::is_sorted(side.begin(), side.end());
+            found.push_back({mask, value});
+        });
+        std::sort(found.begin(), found.end());
+        passed = passed && found == exact && streamed == exact.size();
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (near-min cuts) expected " << exact.size()
+                  << " cuts, got " << found.size() << "\n";
+    }
+
+    // disconnection probability against the exact sum over every failure set, at a failure rate that
+    // samples directly and at one low enough for the near-minimum cut estimator
+    for (const auto& test : cactusTests) {
+        if (test.n < 2 || test.edges.size() > 12) continue;
+        bool passed = true;
+        for (double p : {0.3, 0.01}) {
+            double exact = 0.0;
+            for (unsigned failed = 0; failed < (1u << test.edges.size()); ++failed) {
+                double probability = 1.0;
+                karger::UnionFind<int> survivors(test.n);
+                for (std::size_t i = 0; i < test.edges.size(); ++i) {
+                    bool fails = (failed >> i) & 1u;
+                    probability *= fails ? p : 1.0 - p;
+                    if (!fails) survivors.unite(test.edges[i].u, test.edges[i].v);
+                }
+                if (survivors.components() > 1) exact += probability;
+            }
+            double estimate = karger::disconnectionProbability(test.n, test.edges, p, 0.1, 11, 2);
+            passed = passed && std::abs(estimate - exact) <= 0.1 * exact;
+        }
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (disconnection probability)\n";
+    }
+
+    // weighted Stoer-Wagner with unit weights is the unweighted one, and graphs this small sit below the
+    // sparsifier's sampling rate, so it keeps every pair at its multiplicity and the min cut is exact
+    for (const auto& test : tests) {
+        std::vector<double> unit(test.edges.size(), 1.0);
+        double weighted = karger::minCutStoerWagner(test.n, test.edges, unit);
+        karger::SparsifiedGraph sparse = karger::sparsifyCuts(test.n, test.edges, 0.5, 3);
+        double total = 0.0;
+        for (double w : sparse.weights) total += w;
+        std::size_t loops = std::count_if(test.edges.begin(), test.edges.end(), [](const karger::Edge& e) { return e.u == e.v; });
+        double sparsified = karger::minCutSparsified(test.n, test.edges, 0.5, 3);
+        bool passed = weighted == test.expected && sparsified == test.expected && total == test.edges.size() - loops;
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (sparsified) expected " << test.expected << ", got "
+                  << weighted << " / " << sparsified << "\n";
+    }
+
+    // the complete graph on 2000 vertices is dense enough to be sampled: the sparsifier must keep well under
+    // half of its pairs and still hold the min cut within 1 +- eps
+    {
+        const int n = 2000;
+        const double eps = 0.5;
+        std::vector<karger::Edge> complete;
+        for (int u = 0; u < n; ++u) {
+            for (int v = u + 1; v < n; ++v) complete.push_back({u, v});
+        }
+        karger::SparsifiedGraph sparse = karger::sparsifyCuts(n, complete, eps, 5);
+        double cut = karger::minCutHaoOrlin(sparse.n, sparse.edges, sparse.weights);
+        bool passed = 2 * sparse.edges.size() < complete.size() && cut >= (1.0 - eps) * (n - 1) && cut <= (1.0 + eps) * (n - 1);
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] complete K" << n << " (sparsified) kept " << sparse.edges.size() << " of "
+                  << complete.size() << ", cut " << cut << " for " << n - 1 << "\n";
+    }
+
+    // the approximate route returns a real cut within 1 + epsilon: the small graphs fall back to sparse
+    // Stoer-Wagner (Hao-Orlin is off so sampling has only that to beat), a dense regular graph (min cut =
+    // its degree) is solved on samples, and an epsilon outside (0, 1] throws
+    {
+        karger::MinCutOptions approximate;
+        approximate.guarantee = karger::Guarantee::Approximate;
+        approximate.epsilon = 0.5;
+        approximate.bitmaskMaxVertices = 0;
+        approximate.denseMaxVertices = 0;
+        approximate.haoOrlin = false;
+        std::vector<TestCase> approximateTests = tests;
+        karger::GeneratedGraph dense = karger::generateRandomRegular(300, 4000);
+        approximateTests.push_back({"generated dense regular", dense.n, dense.edges, dense.minCut});
+        for (const auto& test : approximateTests) {
+            karger::MinCutReport report;
+            int cut = karger::minCut(test.n, test.edges, approximate, &report);
+            bool sampled = report.engine == karger::Engine::SampledStoerWagner;
+            bool passed = cut >= test.expected && cut <= 1.5 * test.expected && sampled == (test.n == dense.n);
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (approximate, " << karger::engineName(report.engine)
+                      << ") expected " << test.expected << ", got " << cut << "\n";
+        }
+        for (double epsilon : {0.0, -0.5, 1.5}) {
+            karger::MinCutOptions invalid = approximate;
+            invalid.epsilon = epsilon;
+            bool threw = false;
+            try {
+                karger::minCut(tests[0].n, tests[0].edges, invalid);
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            if (!threw) ++failcount;
+            std::cout << "[" << (threw ? "PASS" : "FAIL") << "] epsilon " << epsilon << " rejected (approximate)\n";
+        }
+    }
+
+    // Matula's estimate is a real cut no worse than (2 + eps) times the min cut
+    for (const auto& test : cactusTests) {
+        bool passed = true;
+        int worst = test.expected;
+        for (double eps : {0.1, 0.5, 2.0}) {
+            int estimate = karger::minCutApproxMatula(test.n, test.edges, eps);
+            passed = passed && estimate >= test.expected && estimate <= (2.0 + eps) * test.expected;
+            worst = std::max(worst, estimate);
+        }
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (matula) expected " << test.expected << ", worst "
+                  << worst << "\n";
+    }
+
+    // Hao-Orlin is exact: the known min cut unweighted, and Stoer-Wagner's value under random weights
+    {
+        std::vector<TestCase> flowTests = cactusTests;
+        karger::GeneratedGraph rmat = karger::generateRmat(9, 6, 3, 2);
+        karger::GeneratedGraph grid = karger::generateGrid(20, 30, false);
+        flowTests.push_back({"generated r-mat", rmat.n, rmat.edges, rmat.minCut});
+        flowTests.push_back({"generated grid", grid.n, grid.edges, grid.minCut});
+        std::mt19937_64 rng(5);
+        std::uniform_real_distribution<double> weight(0.0, 4.0);
+        for (const auto& test : flowTests) {
+            std::vector<double> weights(test.edges.size());
+            for (double& w : weights) w = weight(rng);
+            int flow = karger::minCutHaoOrlin(test.n, test.edges);
+            double weighted = karger::minCutHaoOrlin(test.n, test.edges, weights);
+            double reference = karger::minCutStoerWagner(test.n, test.edges, weights);
+            bool passed = flow == test.expected && std::abs(weighted - reference) <= 1e-9 * (1.0 + reference);
+            if (!passed) ++failcount;
+            std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (hao-orlin) expected " << test.expected << ", got "
+                      << flow << ", weighted " << weighted << " / " << reference << "\n";
+        }
+    }
+
+    // ConcurrentUnionFind fed interleaved edges from four threads must end with the sequential partition
+    for (const auto& test : tests) {
+        karger::ConcurrentUnionFind<int> shared(test.n);
+        karger::UnionFind<int> reference(test.n);
+        std::atomic<int> unions{0};
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < 4; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = t; i < test.edges.size(); i += 4) unions += shared.unite(test.edges[i].u, test.edges[i].v);
+            });
+        }
+        for (auto& w : workers) w.join();
+        for (const auto& e : test.edges) reference.unite(e.u, e.v);
+        bool passed = (test.n - unions == reference.components());
+        for (int v = 0; v + 1 < test.n; ++v) passed = passed && shared.same(v, v + 1) == reference.same(v, v + 1);
+        for (const auto& e : test.edges) passed = passed && shared.same(e.u, e.v);
+        if (!passed) ++failcount;
+        std::cout << "[" << (passed ? "PASS" : "FAIL") << "] " << test.name << " (concurrent union-find)\n";
+    }
+
+    std::cout << std::string(50, '-') << "\n";
+    if (failcount == 0) std::cout << "All tests PASSED\n";
+    else std::cout << failcount << " tests FAILED\n";
+    return failcount == 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    karger::MinCutOptions options;
+    std::string path;
+    bool sparseIds = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--test") return runTests() ? 0 : 1;
+        if (arg == "--exact") options.guarantee = karger::Guarantee::Exact;
+        else if (arg == "--heuristic") options.guarantee = karger::Guarantee::Heuristic;
+        else if (arg == "--input" && i + 1 < argc) path = argv[++i];
+        else if (arg == "--sparse-ids") sparseIds = true;
+        else if (arg == "--monte-carlo") {
+            options.guarantee = karger::Guarantee::MonteCarlo;
+            if (i + 1 < argc && argv[i + 1][0] != '-') options.errorProbability = std::stod(argv[++i]);
+        } else if (arg == "--approximate") {
+            options.guarantee = karger::Guarantee::Approximate;
+            if (i + 1 < argc && argv[i + 1][0] != '-') options.epsilon = std::stod(argv[++i]);
+        }
+    }
+    return runCli(options, path, sparseIds);
+}
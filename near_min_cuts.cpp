@@ -0,0 +1,137 @@
+/* Near-minimum cut enumeration
+Karger: contracting uniformly random edges until ceil(2 alpha) supernodes remain keeps any one cut of
+value <= alpha * lambda intact with probability at least 1 / C(n, 2 alpha) (the binomial taken over the
+reals), and there are fewer than C(n, 2 alpha) such cuts. So after
+
+    trials = C(n, 2 alpha) * (ln C(n, 2 alpha) + ln(1 / errorProbability))
+
+contractions, each followed by every bipartition of the supernodes left, all of them have turned up
+with probability at least 1 - errorProbability.
+
+Each trial is a shuffled edge order through UnionFind (reset in O(touched), as in minKCut). The
+bipartitions of the r <= 20 supernodes are valued in O(2^r) total, each from a smaller one by adding
+one supernode. A cut is recognised by the sum of random 64-bit keys over its side without vertex 0, so
+repeats across trials cost a hash lookup and only new cuts are written out for the sink.
+*/
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace karger {
+
+namespace {
+
+constexpr int kMaxSupernodes = 20; // 2^19 bipartitions per trial
+
+template <class Index>
+std::size_t enumerate(Index n, std::span<const BasicEdge<Index>> edges, double alpha, std::size_t trials, std::uint64_t seed,
+                      const BasicCutSink<Index>& sink) {
+    if (!(alpha >= 1.0 && alpha <= kMaxSupernodes / 2)) throw std::invalid_argument("enumerateNearMinCuts needs 1 <= alpha <= 10");
+    if (n <= 1) return 0;
+
+    UnionFind<Index> uf(n);
+    for (const auto& e : edges) uf.unite(e.u, e.v);
+    if (uf.components() > kMaxSupernodes) throw std::invalid_argument("enumerateNearMinCuts needs at most 20 components");
+    uf.reset();
+
+    Index lambda = minCutStoerWagner(n, edges);
+    double bound = alpha * static_cast<double>(lambda);
+    Index target = std::min<Index>(n, static_cast<Index>(std::ceil(2.0 * alpha)));
+
+    std::vector<std::uint64_t> vertexKey(n);
+    for (Index v = 0; v < n; ++v) vertexKey[v] = detail::mix64(seed ^ detail::mix64(static_cast<std::uint64_t>(v) + 1));
+
+    std::mt19937_64 rng(seed);
+    std::vector<std::size_t> order(edges.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::vector<Index> label(n, -1), roots, side;
+    std::vector<std::uint64_t> weight; // r x r, between labelled supernodes
+    std::vector<std::uint64_t> superKey, value, hash;
+    std::unordered_set<std::uint64_t> seen;
+
+    if (target >= n) trials = 1; // nothing to contract, one pass sees every bipartition
+    for (std::size_t t = 0; t < std::max<std::size_t>(trials, 1); ++t) {
+        std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t i : order) {
+            if (uf.components() <= target) break;
+            uf.unite(edges[i].u, edges[i].v);
+        }
+
+        // label the supernodes, vertex 0's first
+        roots.clear();
+        for (Index v = 0; v < n; ++v) {
+            Index r = uf.find(v);
+            if (label[r] == -1) {
+                label[r] = static_cast<Index>(roots.size());
+                roots.push_back(r);
+            }
+        }
+        std::size_t r = roots.size();
+        weight.assign(r * r, 0);
+        superKey.assign(r, 0);
+        for (Index v = 0; v < n; ++v) superKey[label[uf.find(v)]] += vertexKey[v];
+        for (const auto& e : edges) {
+            std::size_t a = label[uf.find(e.u)], b = label[uf.find(e.v)];
+            if (a != b) {
+                ++weight[a * r + b];
+                ++weight[b * r + a];
+            }
+        }
+
+        // bipartitions as masks over supernodes 1..r-1; mask's value from mask minus its lowest supernode
+        std::size_t masks = std::size_t{1} << (r - 1);
+        value.assign(masks, 0);
+        hash.assign(masks, 0);
+        for (std::size_t mask = 1; mask < masks; ++mask) {
+            std::size_t low = std::countr_zero(mask), rest = mask & (mask - 1), s = low + 1;
+            std::uint64_t degree = 0, inside = 0;
+            for (std::size_t j = 0; j < r; ++j) degree += weight[s * r + j];
+            for (std::size_t bits = rest; bits; bits &= bits - 1) inside += weight[s * r + std::countr_zero(bits) + 1];
+            value[mask] = value[rest] + degree - 2 * inside;
+            hash[mask] = hash[rest] + superKey[s];
+            if (static_cast<double>(value[mask]) > bound || !seen.insert(hash[mask]).second) continue;
+
+            side.clear();
+            for (Index v = 0; v < n; ++v) {
+                std::size_t l = label[uf.find(v)];
+                if (l && ((mask >> (l - 1)) & 1u)) side.push_back(v);
+            }
+            sink(static_cast<Index>(value[mask]), side);
+        }
+
+        for (Index root : roots) label[root] = -1;
+        uf.reset();
+    }
+    return seen.size();
+}
+
+}
+
+std::size_t nearMinCutTrials(std::int64_t n, double alpha, double errorProbability) {
+    if (n <= 2) return 1;
+    double k = std::min(2.0 * alpha, static_cast<double>(n));
+    double logBinomial = std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+    double logTrials = logBinomial + std::log(std::max(logBinomial, 0.0) + std::log(1.0 / errorProbability));
+    if (logTrials >= std::log(static_cast<double>(std::numeric_limits<std::size_t>::max()))) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return static_cast<std::size_t>(std::ceil(std::exp(logTrials)));
+}
+
+std::size_t enumerateNearMinCuts(int n, std::span<const Edge> edges, double alpha, std::size_t trials, std::uint64_t seed,
+                                 const CutSink& sink) {
+    return enumerate(n, detail::intEdges(edges), alpha, trials, seed, sink);
+}
+
+std::size_t enumerateNearMinCuts(std::int64_t n, std::span<const Edge64> edges, double alpha, std::size_t trials,
+                                 std::uint64_t seed, const CutSink64& sink) {
+    return enumerate(n, edges, alpha, trials, seed, sink);
+}
+
+}
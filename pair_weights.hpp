@@ -0,0 +1,63 @@
+#ifndef KARGER_PAIR_WEIGHTS_HPP
+#define KARGER_PAIR_WEIGHTS_HPP
+
+// Internal helper shared by the dispatcher and the sparse Stoer-Wagner engine, not part of the public API.
+
+#include "karger.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace karger::detail {
+
+template <class Index, class Weight>
+struct WeightedPair {
+    Index a, b; // a < b
+    Weight weight;
+};
+
+// the distinct vertex pairs of the non-loop edges in sorted order, each weighted by its multiplicity;
+// 32-bit ids are packed into one 64-bit key so the sort only moves 8 bytes per edge
+template <class Weight, class Index>
+std::vector<WeightedPair<Index, Weight>> collapseParallelEdges(std::span<const BasicEdge<Index>> edges) {
+    std::vector<WeightedPair<Index, Weight>> out;
+    auto runs = [&out](const auto& keys, auto unpack) {
+        for (std::size_t i = 0; i < keys.size();) {
+            std::size_t j = i;
+            while (j < keys.size() && keys[j] == keys[i]) ++j;
+            auto [a, b] = unpack(keys[i]);
+            out.push_back({a, b, static_cast<Weight>(j - i)});
+            i = j;
+        }
+    };
+
+    if constexpr (sizeof(Index) <= sizeof(std::uint32_t)) {
+        std::vector<std::uint64_t> keys;
+        keys.reserve(edges.size());
+        for (const auto& e : edges) {
+            if (e.u == e.v) continue;
+            std::uint64_t a = static_cast<std::uint32_t>(std::min(e.u, e.v));
+            std::uint64_t b = static_cast<std::uint32_t>(std::max(e.u, e.v));
+            keys.push_back((a << 32) | b);
+        }
+        std::sort(keys.begin(), keys.end());
+        runs(keys, [](std::uint64_t key) {
+            return std::pair<Index, Index>(static_cast<Index>(key >> 32), static_cast<Index>(key & 0xffffffffu));
+        });
+    } else {
+        std::vector<std::pair<Index, Index>> keys;
+        keys.reserve(edges.size());
+        for (const auto& e : edges) {
+            if (e.u != e.v) keys.push_back({std::min(e.u, e.v), std::max(e.u, e.v)});
+        }
+        std::sort(keys.begin(), keys.end());
+        runs(keys, [](const std::pair<Index, Index>& key) { return key; });
+    }
+    return out;
+}
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef KARGER_PARALLEL_HPP
+#define KARGER_PARALLEL_HPP
+
+// Internal helpers shared by the multi-threaded parts of libkarger, not part of the public API.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace karger::detail {
+
+// 0 (or less) means one thread per hardware thread
+inline int resolveThreads(int threads) {
+    if (threads > 0) return threads;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+// calls f(i) for every i in [0, count), handing indices out dynamically to `threads` workers
+// (the calling thread is one of them), returns once every call has finished
+template <class F>
+void parallelFor(std::size_t count, int threads, F&& f) {
+    std::size_t workers = std::min<std::size_t>(static_cast<std::size_t>(resolveThreads(threads)), count);
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) f(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) f(i);
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t = 1; t < workers; ++t) pool.emplace_back(work);
+    work();
+    for (auto& thread : pool) thread.join();
+}
+
+// splitmix64 finaliser, used to derive independent seeds and hashes from one user seed
+inline std::uint64_t mix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+/* Parallel contraction
+One Karger trial contracts uniformly random edges until two supernodes remain. Giving every edge an
+independent random priority and contracting in priority order is the same process, and by
+spanning_forest.hpp that is the random-priority minimum spanning forest minus its heaviest edge.
+
+- minCutRandomisedParallel: priorities are hashes of (seed, edge index), ties broken by index, and the
+  forest comes from parallel Boruvka. Each run has the distribution of one minCutRandomised trial, but
+  not the same cut for the same seed.
+- minCutFixedPermutationParallel: the order of minCutFixedPermutation, (min(u, v), max(u, v)) with the
+  edge index breaking ties between parallel edges, which are interchangeable there. The forest and so
+  the supernodes are exactly the sequential ones, so the cut is identical for every thread count.
+
+The crossing edges of the two final supernodes are counted in parallel as well. Every engine here is
+a template over the index type, int or std::int64_t.
+*/
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include "spanning_forest.hpp"
+
+namespace karger {
+
+namespace {
+
+template <class Index>
+Index randomisedParallel(Index n, std::span<const BasicEdge<Index>> edges, std::uint64_t seed, int threads) {
+    if (n <= 1 || edges.empty()) return 0;
+
+    const std::uint64_t salt = detail::mix64(seed);
+    auto before = [salt](std::size_t i, std::size_t j) {
+        std::uint64_t pi = detail::mix64(salt ^ i), pj = detail::mix64(salt ^ j);
+        return pi < pj || (pi == pj && i < j);
+    };
+    std::vector<std::size_t> forest = detail::spanningForest(n, edges, before, threads);
+
+    // more than two components never contract down to two supernodes, as in minCutRandomised
+    if (n - static_cast<Index>(forest.size()) > 2) return 0;
+    std::size_t contractions = std::min<std::size_t>(forest.size(), static_cast<std::size_t>(n - 2));
+    return detail::cutAfterContracting(n, edges, std::span<const std::size_t>(forest.data(), contractions), threads);
+}
+
+template <class Index>
+Index fixedPermutationParallel(Index n, std::span<const BasicEdge<Index>> edges, int threads) {
+    if (n <= 1 || edges.empty()) return 0;
+
+    auto before = [edges](std::size_t i, std::size_t j) {
+        Index iu = std::min(edges[i].u, edges[i].v), iv = std::max(edges[i].u, edges[i].v);
+        Index ju = std::min(edges[j].u, edges[j].v), jv = std::max(edges[j].u, edges[j].v);
+        if (iu != ju) return iu < ju;
+        if (iv != jv) return iv < jv;
+        return i < j;
+    };
+    std::vector<std::size_t> forest = detail::spanningForest(n, edges, before, threads);
+
+    // the sequential scan stops at two supernodes, or runs out of edges with more left
+    std::size_t contractions = std::min<std::size_t>(forest.size(), static_cast<std::size_t>(n - 2));
+    return detail::cutAfterContracting(n, edges, std::span<const std::size_t>(forest.data(), contractions), threads);
+}
+
+}
+
+int minCutRandomisedParallel(int n, std::span<const Edge> edges, std::uint64_t seed, int threads) {
+    return randomisedParallel(n, detail::intEdges(edges), seed, threads);
+}
+
+std::int64_t minCutRandomisedParallel(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed, int threads) {
+    return randomisedParallel(n, edges, seed, threads);
+}
+
+int minCutFixedPermutationParallel(int n, std::span<const Edge> edges, int threads) {
+    return fixedPermutationParallel(n, detail::intEdges(edges), threads);
+}
+
+std::int64_t minCutFixedPermutationParallel(std::int64_t n, std::span<const Edge64> edges, int threads) {
+    return fixedPermutationParallel(n, edges, threads);
+}
+
+}
@@ -7,81 +7,107 @@ comparison with deterministic variants. It also aligns with the course focus on
 */
 
 #include "karger.hpp"
+#include <algorithm>
 #include <random>
-#include <iostream>
 #include <vector>
-#include <string>
 
 /* Dom S - Algorithm 1 - Randomised Karger Min Cut */
 
-int karger::minCutRandomised(int n, const std::vector<Edge>& edges, std::uint64_t seed) {
-    if (n <= 1 || edges.empty()) return 0;
+namespace {
 
-    // initialise disjoint set
-    std::vector<int> parent(n), rank(n, 0);
-    for (int i = 0; i < n; ++i) parent[i] = i;
+// shared by every overload, with NullObserver every hook inlines away; Index is int or std::int64_t
+template <class Index, class Obs>
+Index randomisedTrial(Index n, std::span<const karger::BasicEdge<Index>> edges, std::uint64_t seed, Obs& observer) {
+    if (n <= 1 || edges.empty()) {
+        observer.onTrialComplete(seed, 0);
+        observer.onResult(0);
+        return 0;
+    }
+
+    karger::UnionFind<Index> uf(n);
 
     // rng setup
     std::mt19937_64 rng(seed);
     std::uniform_int_distribution<std::size_t> pick(0, edges.size() - 1);
 
-    // contraction loop
-    int supernodes = n;
+    // contraction loop. A graph with more than two components never gets down to two supernodes and
+    // would spin on self-loops forever, so after every m self-loops in a row one pass looks for an edge
+    // still crossing supernodes; the pass costs no more than the picks it follows.
+    Index supernodes = n;
+    std::size_t misses = 0;
     while (supernodes > 2) {
         const auto& e = edges[pick(rng)];
-        int a = findParent(parent, e.u);
-        int b = findParent(parent, e.v);
-        if (a == b) continue;
-        unionSets(parent, rank, a, b);
+        Index a = uf.find(e.u);
+        Index b = uf.find(e.v);
+        if (a == b) {
+            if (++misses < edges.size()) continue;
+            misses = 0;
+            bool crossing = std::any_of(edges.begin(), edges.end(), [&](const auto& f) { return !uf.same(f.u, f.v); });
+            if (crossing) continue;
+            observer.onTrialComplete(seed, 0);
+            observer.onResult(0);
+            return 0;
+        }
+        misses = 0;
+        uf.unite(a, b);
         --supernodes;
+        observer.onContraction(a, b, supernodes);
     }
 
     // identify remaining supernodes
-    int repA = -1, repB = -1;
-    for (int i = 0; i < n; ++i) {
-        int r = findParent(parent, i);
+    Index repA = -1, repB = -1;
+    for (Index i = 0; i < n; ++i) {
+        Index r = uf.find(i);
         if (repA == -1) repA = r;
         else if (r != repA) { repB = r; break; }
     }
-    if (repB == -1) return 0;
+    if (repB == -1) {
+        observer.onTrialComplete(seed, 0);
+        observer.onResult(0);
+        return 0;
+    }
 
     // count crossing edges
-    int cutSize = 0;
+    Index cutSize = 0;
     for (const auto& e : edges) {
-        int a = findParent(parent, e.u);
-        int b = findParent(parent, e.v);
+        Index a = uf.find(e.u);
+        Index b = uf.find(e.v);
         if ((a == repA && b == repB) || (a == repB && b == repA)) ++cutSize;
     }
 
-    std::cout << "Final cut size (Randomised Karger, seed " << seed << "): " << cutSize << "\n";
+    observer.onTrialComplete(seed, cutSize);
+    observer.onResult(cutSize);
     return cutSize;
 }
 
-// Dom S Test Cases - Randomised Karger
-int main() {
-    std::cout << "Dom S - Randomised Karger Tests";
-
-    struct TestCase { 
-        std::string name; 
-        int n; 
-        std::vector<karger::Edge> edges; 
-    };
-
-    std::vector<TestCase> domSTests = {
-        {"simple 4-node", 4, {{0,1},{0,2},{1,2},{1,3},{2,3}}},
-        {"triangle min cut 2", 3, {{0,1},{1,2},{0,2}}},
-        {"two cliques bridge", 6, {{0,1},{1,2},{0,2},{3,4},{4,5},{3,5},{2,3}}},
-        {"square cycle min cut 2", 4, {{0,1},{1,2},{2,3},{3,0}}},
-        {"star graph min cut 1", 5, {{0,1},{0,2},{0,3},{0,4}}},
-        {"complete k4 cut 3", 4, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}}},
-        {"disconnected cut 0", 4, {{0,1}}}
-    };
-
-    for (const auto& test : domSTests) {
-        std::cout << "test: " << test.name << "\n";
-        karger::minCutRandomised(test.n, test.edges, 123);
-        std::cout << "";
-    }
+}
+
+int karger::minCutRandomised(int n, std::span<const Edge> edges, std::uint64_t seed) {
+    NullObserver observer;
+    return randomisedTrial(n, detail::intEdges(edges), seed, observer);
+}
+
+int karger::minCutRandomised(int n, std::span<const Edge> edges, std::uint64_t seed, Observer& observer) {
+    return randomisedTrial(n, detail::intEdges(edges), seed, observer);
+}
+
+std::int64_t karger::minCutRandomised(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed) {
+    NullObserver observer;
+    return randomisedTrial(n, edges, seed, observer);
+}
+
+std::int64_t karger::minCutRandomised(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed, Observer& observer) {
+    return randomisedTrial(n, edges, seed, observer);
+}
+
+karger::Dendrogram karger::contractionDendrogramRandomised(int n, std::span<const Edge> edges, std::uint64_t seed) {
+    MergeRecorder<int> recorder;
+    randomisedTrial(n, detail::intEdges(edges), seed, recorder);
+    return Dendrogram(n, edges, std::move(recorder.merges));
+}
 
-    return 0;
+karger::Dendrogram64 karger::contractionDendrogramRandomised(std::int64_t n, std::span<const Edge64> edges, std::uint64_t seed) {
+    MergeRecorder<std::int64_t> recorder;
+    randomisedTrial(n, edges, seed, recorder);
+    return Dendrogram64(n, edges, std::move(recorder.merges));
 }
@@ -0,0 +1,56 @@
+/* Dom S
+Test driver for the Randomised Karger engine (randomised_karger.cpp).
+Pass --trace to print every contraction through a karger::Observer.
+*/
+
+#include "karger.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+
+// prints what the engine used to print unconditionally, plus each contraction
+struct TraceObserver : karger::Observer {
+    std::uint64_t seed = 0;
+    void onContraction(std::int64_t a, std::int64_t b, std::int64_t supernodes) override {
+        std::cout << "  contract " << a << " + " << b << " (" << supernodes << " supernodes left)\n";
+    }
+    void onTrialComplete(std::uint64_t trial, std::int64_t) override { seed = trial; }
+    void onResult(std::int64_t cut) override {
+        std::cout << "Final cut size (Randomised Karger, seed " << seed << "): " << cut << "\n";
+    }
+};
+
+// Dom S Test Cases - Randomised Karger
+int main(int argc, char* argv[]) {
+    bool trace = argc > 1 && std::string(argv[1]) == "--trace";
+    std::cout << "Dom S - Randomised Karger Tests\n";
+
+    struct TestCase { 
+        std::string name; 
+        int n; 
+        std::vector<karger::Edge> edges; 
+    };
+
+    std::vector<TestCase> domSTests = {
+        {"simple 4-node", 4, {{0,1},{0,2},{1,2},{1,3},{2,3}}},
+        {"triangle min cut 2", 3, {{0,1},{1,2},{0,2}}},
+        {"two cliques bridge", 6, {{0,1},{1,2},{0,2},{3,4},{4,5},{3,5},{2,3}}},
+        {"square cycle min cut 2", 4, {{0,1},{1,2},{2,3},{3,0}}},
+        {"star graph min cut 1", 5, {{0,1},{0,2},{0,3},{0,4}}},
+        {"complete k4 cut 3", 4, {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}}},
+        {"disconnected cut 0", 4, {{0,1}}}
+    };
+
+    for (const auto& test : domSTests) {
+        std::cout << "test: " << test.name << "\n";
+        if (trace) {
+            TraceObserver observer;
+            karger::minCutRandomised(test.n, test.edges, 123, observer);
+        } else {
+            int cut = karger::minCutRandomised(test.n, test.edges, 123);
+            std::cout << "Final cut size (Randomised Karger, seed 123): " << cut << "\n";
+        }
+    }
+
+    return 0;
+}
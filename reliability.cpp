@@ -0,0 +1,180 @@
+/* Network reliability
+disconnectionProbability estimates FAIL(p), the probability that the graph falls apart when every edge
+fails independently with probability p, following Karger's FPRAS. The graph disconnects exactly when all
+edges of some cut fail, and a cut of value c fails with probability p^c, so FAIL >= p^lambda.
+
+- When p^lambda is not tiny, plain Monte Carlo works: 3 ln(2 / 0.01) / (eps^2 p^lambda) samples of the
+  surviving edges, each checked for connectivity with UnionFind (reset in O(touched) between samples).
+- When p^lambda = n^-(2 + d) is tiny that count explodes, but then only near-minimum cuts matter: cuts of
+  value above alpha * lambda, alpha = (2 + d) / d + ln(1 / eps) / (d ln n), fail together with probability
+  below eps * p^lambda. Those cuts come from enumerateNearMinCuts, and the probability of their union
+  is estimated with Karp-Luby-Madras: draw a cut C with probability proportional to p^|C|, fail the rest
+  of the edges independently, and average 1 / (cuts that failed). The mean times the sum of the p^|C|
+  is unbiased, and 3 K ln(2 / 0.01) / eps^2 samples for K cuts suffice.
+
+The path whose estimated work is smaller is taken, so moderately reliable graphs, where Karger's cut count
+is far beyond plain sampling, still use the naive estimator. Either way the result is within a factor
+1 +- eps with probability >= 0.99. Samples are split into a fixed number of chunks, each with its own
+generator, which run in parallel; the estimate depends on the seed, not on the thread count.
+*/
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+constexpr std::size_t kChunks = 64;            // sample chunks, fixed so the estimate ignores the thread count
+constexpr double kConfidence = 0.01;            // chance of missing the 1 +- eps window
+constexpr double kMaxSamples = 1e15;            // beyond this neither path finishes, the cheaper one is still run
+
+double sampleCount(double inverseMean, double eps) {
+    return std::ceil(3.0 * std::log(2.0 / kConfidence) * inverseMean / (eps * eps));
+}
+
+// runs `samples` draws of draw(rng, scratch) split over kChunks generators, returns their sum
+template <class Draw, class Scratch>
+double sumSamples(std::size_t samples, std::uint64_t seed, int threads, Scratch prototype, Draw draw) {
+    std::vector<double> sums(kChunks, 0.0);
+    detail::parallelFor(kChunks, threads, [&](std::size_t chunk) {
+        std::size_t begin = samples * chunk / kChunks, end = samples * (chunk + 1) / kChunks;
+        std::mt19937_64 rng(detail::mix64(seed ^ detail::mix64(chunk)));
+        Scratch scratch = prototype;
+        double sum = 0.0;
+        for (std::size_t s = begin; s < end; ++s) sum += draw(rng, scratch);
+        sums[chunk] = sum;
+    });
+    double total = 0.0;
+    for (double s : sums) total += s;
+    return total;
+}
+
+// failed edges of one sample, as positions jumped to geometrically (O(p m) draws rather than m)
+template <class F>
+void failEdges(std::size_t m, double p, std::mt19937_64& rng, F&& fail) {
+    std::geometric_distribution<std::size_t> gap(p);
+    for (std::size_t i = gap(rng); i < m; i += 1 + gap(rng)) fail(i);
+}
+
+template <class Index>
+double naive(Index n, std::span<const BasicEdge<Index>> edges, double p, std::size_t samples, std::uint64_t seed, int threads) {
+    struct Scratch {
+        UnionFind<Index> uf;
+        std::vector<std::uint8_t> failed;
+        std::vector<std::size_t> touched;
+    };
+    double disconnected = sumSamples(samples, seed, threads, Scratch{UnionFind<Index>(n), std::vector<std::uint8_t>(edges.size(), 0), {}},
+                                     [&](std::mt19937_64& rng, Scratch& s) {
+        failEdges(edges.size(), p, rng, [&](std::size_t i) {
+            s.failed[i] = 1;
+            s.touched.push_back(i);
+        });
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            if (!s.failed[i]) s.uf.unite(edges[i].u, edges[i].v);
+        }
+        double out = s.uf.components() > 1 ? 1.0 : 0.0;
+        for (std::size_t i : s.touched) s.failed[i] = 0;
+        s.touched.clear();
+        s.uf.reset();
+        return out;
+    });
+    return disconnected / static_cast<double>(samples);
+}
+
+// Karp-Luby-Madras over the cuts, each a list of edge indices in cutEdges[cutBegin[c], cutBegin[c + 1])
+double unionOfCuts(std::size_t m, const std::vector<std::size_t>& cutBegin, const std::vector<std::size_t>& cutEdges, double p,
+                   double eps, std::uint64_t seed, int threads) {
+    std::size_t cuts = cutBegin.size() - 1;
+    std::size_t smallest = std::numeric_limits<std::size_t>::max();
+    for (std::size_t c = 0; c < cuts; ++c) smallest = std::min(smallest, cutBegin[c + 1] - cutBegin[c]);
+
+    // weights relative to the min cut, so nothing underflows
+    std::vector<double> weight(cuts);
+    double total = 0.0;
+    for (std::size_t c = 0; c < cuts; ++c) total += weight[c] = std::pow(p, static_cast<double>(cutBegin[c + 1] - cutBegin[c] - smallest));
+    std::discrete_distribution<std::size_t> pick(weight.begin(), weight.end());
+
+    auto failedCut = [&](const std::vector<std::uint8_t>& failed, std::size_t c) {
+        for (std::size_t j = cutBegin[c]; j < cutBegin[c + 1]; ++j) {
+            if (!failed[cutEdges[j]]) return false;
+        }
+        return true;
+    };
+
+    struct Scratch {
+        std::discrete_distribution<std::size_t> pick;
+        std::vector<std::uint8_t> failed;
+        std::vector<std::size_t> touched;
+    };
+    std::size_t samples = static_cast<std::size_t>(std::min(sampleCount(static_cast<double>(cuts), eps), kMaxSamples));
+    double coverage = sumSamples(samples, seed, threads, Scratch{pick, std::vector<std::uint8_t>(m, 0), {}},
+                                 [&](std::mt19937_64& rng, Scratch& s) {
+        auto fail = [&](std::size_t i) {
+            if (!s.failed[i]) s.touched.push_back(i);
+            s.failed[i] = 1;
+        };
+        std::size_t chosen = s.pick(rng);
+        for (std::size_t j = cutBegin[chosen]; j < cutBegin[chosen + 1]; ++j) fail(cutEdges[j]);
+        failEdges(m, p, rng, fail);
+        std::size_t covered = 0;
+        for (std::size_t c = 0; c < cuts; ++c) covered += failedCut(s.failed, c);
+        for (std::size_t i : s.touched) s.failed[i] = 0;
+        s.touched.clear();
+        return 1.0 / static_cast<double>(covered);
+    });
+    return std::pow(p, static_cast<double>(smallest)) * total * coverage / static_cast<double>(samples);
+}
+
+template <class Index>
+double estimate(Index n, std::span<const BasicEdge<Index>> edges, double p, double eps, std::uint64_t seed, int threads) {
+    if (!(p >= 0.0 && p <= 1.0)) throw std::invalid_argument("disconnectionProbability needs 0 <= p <= 1");
+    if (!(eps > 0.0 && eps < 1.0)) throw std::invalid_argument("disconnectionProbability needs 0 < eps < 1");
+    if (n <= 1) return 0.0;
+    Index lambda = minCutStoerWagner(n, edges);
+    if (lambda == 0 || p == 1.0) return 1.0;
+    if (p == 0.0) return 0.0;
+
+    double m = static_cast<double>(edges.size());
+    double logFloor = lambda * std::log(p); // ln p^lambda
+    double naiveSamples = sampleCount(std::exp(-logFloor), eps);
+    double naiveWork = naiveSamples * m;
+
+    double d = -logFloor / std::log(static_cast<double>(n)) - 2.0;
+    if (n > 2 && d > 0.0) {
+        double alpha = std::max(1.0, (2.0 + d) / d + std::log(1.0 / eps) / (d * std::log(static_cast<double>(n))));
+        double enumerationTrials = static_cast<double>(nearMinCutTrials(n, alpha, kConfidence));
+        if (alpha <= 10.0 && enumerationTrials < kMaxSamples && enumerationTrials * m < naiveWork) {
+            std::vector<std::uint8_t> inSide(n, 0);
+            std::vector<std::size_t> cutBegin{0}, cutEdges;
+            enumerateNearMinCuts(n, edges, alpha, static_cast<std::size_t>(enumerationTrials), seed,
+                                 [&](Index, std::span<const Index> side) {
+                for (Index v : side) inSide[v] = 1;
+                for (std::size_t i = 0; i < edges.size(); ++i) {
+                    if (inSide[edges[i].u] != inSide[edges[i].v]) cutEdges.push_back(i);
+                }
+                cutBegin.push_back(cutEdges.size());
+                for (Index v : side) inSide[v] = 0;
+            });
+            return unionOfCuts(edges.size(), cutBegin, cutEdges, p, eps, detail::mix64(seed), threads);
+        }
+    }
+    return naive(n, edges, p, static_cast<std::size_t>(std::min(naiveSamples, kMaxSamples)), detail::mix64(seed), threads);
+}
+
+}
+
+double disconnectionProbability(int n, std::span<const Edge> edges, double pFail, double eps, std::uint64_t seed, int threads) {
+    return estimate(n, detail::intEdges(edges), pFail, eps, seed, threads);
+}
+
+double disconnectionProbability(std::int64_t n, std::span<const Edge64> edges, double pFail, double eps, std::uint64_t seed,
+                                int threads) {
+    return estimate(n, edges, pFail, eps, seed, threads);
+}
+
+}
@@ -0,0 +1,136 @@
+#ifndef KARGER_SPANNING_FOREST_HPP
+#define KARGER_SPANNING_FOREST_HPP
+
+// Internal helpers for the parallel contraction engines, not part of the public API.
+//
+// Contracting edges in a fixed total order until two supernodes remain is Kruskal stopped early: the
+// contracted edges are the first n - 2 edges of the minimum spanning forest under that order. Boruvka
+// finds the same forest without sorting the edges, in O(log n) rounds that each split the live edges
+// over threads, and only the forest (at most n - 1 edges) is sorted afterwards.
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace karger::detail {
+
+constexpr std::size_t kMinForestChunk = std::size_t{1} << 14; // edges per task, below this threads cost more than they save
+
+inline std::size_t forestChunks(std::size_t count, int threads) {
+    return std::min<std::size_t>(resolveThreads(threads), count / kMinForestChunk + 1);
+}
+
+// indices of the minimum spanning forest edges under the strict total order before(i, j) on edge
+// indices, sorted by that order. Self-loops are never picked.
+template <class Index, class Before>
+std::vector<std::size_t> spanningForest(Index n, std::span<const BasicEdge<Index>> edges, Before before, int threads) {
+    constexpr std::uint64_t kNone = std::numeric_limits<std::uint64_t>::max();
+    ConcurrentUnionFind<Index> uf(n);
+    std::vector<std::atomic<std::uint64_t>> lightest(static_cast<std::size_t>(n));
+    for (auto& slot : lightest) slot.store(kNone, std::memory_order_relaxed);
+
+    auto offer = [&](Index root, std::size_t i) {
+        std::uint64_t current = lightest[root].load(std::memory_order_relaxed);
+        while ((current == kNone || before(i, current)) &&
+               !lightest[root].compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+        }
+    };
+
+    // live edges still join two different trees; each round drops the ones that stopped doing so
+    std::vector<std::size_t> live;
+    live.reserve(edges.size());
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (edges[i].u != edges[i].v) live.push_back(i);
+    }
+
+    std::vector<std::size_t> forest;
+    while (!live.empty()) {
+        // every tree offers itself its lightest outgoing edge, the survivors move to per-chunk lists
+        std::size_t chunks = forestChunks(live.size(), threads);
+        std::vector<std::vector<std::size_t>> kept(chunks);
+        parallelFor(chunks, threads, [&](std::size_t k) {
+            std::size_t begin = live.size() * k / chunks, end = live.size() * (k + 1) / chunks;
+            for (std::size_t j = begin; j < end; ++j) {
+                std::size_t i = live[j];
+                Index a = uf.find(edges[i].u);
+                Index b = uf.find(edges[i].v);
+                if (a == b) continue;
+                offer(a, i);
+                offer(b, i);
+                kept[k].push_back(i);
+            }
+        });
+
+        // link every tree along its pick. With a strict order the picks are all forest edges, so each
+        // distinct pick unites exactly once (two trees that picked the same edge unite it once).
+        std::size_t vertexChunks = forestChunks(static_cast<std::size_t>(n), threads);
+        std::vector<std::vector<std::size_t>> picked(vertexChunks);
+        parallelFor(vertexChunks, threads, [&](std::size_t k) {
+            Index begin = static_cast<Index>(static_cast<std::size_t>(n) * k / vertexChunks);
+            Index end = static_cast<Index>(static_cast<std::size_t>(n) * (k + 1) / vertexChunks);
+            for (Index r = begin; r < end; ++r) {
+                std::uint64_t i = lightest[r].load(std::memory_order_relaxed);
+                if (i == kNone) continue;
+                lightest[r].store(kNone, std::memory_order_relaxed);
+                if (uf.unite(edges[i].u, edges[i].v)) picked[k].push_back(i);
+            }
+        });
+
+        bool grew = false;
+        for (const auto& p : picked) {
+            forest.insert(forest.end(), p.begin(), p.end());
+            grew = grew || !p.empty();
+        }
+        if (!grew) break;
+        live.clear();
+        for (const auto& list : kept) live.insert(live.end(), list.begin(), list.end());
+    }
+
+    std::sort(forest.begin(), forest.end(), before);
+    return forest;
+}
+
+// the cut left after contracting edges[forest[0..contractions)]: the edges between the supernode of
+// vertex 0 and the supernode of the lowest vertex outside it, 0 when everything is one supernode
+template <class Index>
+Index cutAfterContracting(Index n, std::span<const BasicEdge<Index>> edges, std::span<const std::size_t> contracted,
+                          int threads) {
+    ConcurrentUnionFind<Index> uf(n);
+    std::size_t linkChunks = forestChunks(contracted.size(), threads);
+    parallelFor(linkChunks, threads, [&](std::size_t k) {
+        std::size_t begin = contracted.size() * k / linkChunks, end = contracted.size() * (k + 1) / linkChunks;
+        for (std::size_t j = begin; j < end; ++j) uf.unite(edges[contracted[j]].u, edges[contracted[j]].v);
+    });
+
+    Index repA = uf.find(0), repB = -1;
+    for (Index v = 1; v < n && repB == -1; ++v) {
+        Index r = uf.find(v);
+        if (r != repA) repB = r;
+    }
+    if (repB == -1) return 0;
+
+    std::size_t chunks = forestChunks(edges.size(), threads);
+    std::vector<Index> counts(chunks, 0);
+    parallelFor(chunks, threads, [&](std::size_t k) {
+        std::size_t begin = edges.size() * k / chunks, end = edges.size() * (k + 1) / chunks;
+        Index count = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            Index a = uf.find(edges[i].u);
+            Index b = uf.find(edges[i].v);
+            count += (a == repA && b == repB) || (a == repB && b == repA);
+        }
+        counts[k] = count;
+    });
+    Index cut = 0;
+    for (Index c : counts) cut += c;
+    return cut;
+}
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+/* Cut sparsifier
+Benczur-Karger sampling: keep each edge e with probability p_e = min(1, rho / k_e) and give the survivors
+weight 1 / p_e, where k_e is a lower bound on e's strength (the largest min cut of a vertex-induced
+subgraph holding e). Write the graph as a sum over strength levels k_1 < k_2 < ...: level j holds the edges
+of strength >= k_j, edge e weighted (k_j - k_(j-1)) / k_e. Sampling makes every sampled edge of level j
+worth the same (k_j - k_(j-1)) / rho, and each component of level j is a strong component where every cut
+C has sum 1 / k_e >= 1 (its strongest edge's strong component alone puts k_e edges of strength k_e in C).
+So Karger's uniform sampling bound applies level by level, and rho = 3 (d + 4) ln n / eps^2 keeps every
+cut within 1 +- eps with probability 1 - O(n^-d) (Benczur-Karger's compression theorem; the extra 2 in
+d + 4 pays for the union over up to n^2 levels). Here d = 1, rho = 15 ln n / eps^2. Underestimating k_e
+only raises p_e, so lower bounds are enough.
+
+The lower bounds come from splitting the graph into pieces, each a vertex-induced subgraph with a floor
+that bounds the strength of all its edges from below (1 for the whole graph):
+
+- peel: vertices of degree <= rho leave one at a time, their remaining edges keep the floor. That is at
+  most rho edges per vertex, and what is left (min degree > rho) goes back on the stack per component;
+- certify: Matula-style contraction (contractConnectedPairs) with the cap K = ceil(U / (1 + slack)) just
+  under the smallest supernode degree U seen so far. A cut below every cap used is never contracted, so
+  once one supernode is left lambda >= the smallest cap; slack starts at 1/8 and doubles, up to Matula's
+  own 3/2, after any round that drops fewer than 1/8 of the supernodes;
+- stop: once the piece's weight is at most 2 floor (n' - 1), its edges keep the floor;
+- split: otherwise the piece's edges are at least as strong as its lambda, the edges of the smallest
+  supernode cut keep that, and both sides go back on the stack with it as their floor.
+
+Leaves are disjoint and charge at most 2 (n' - 1) to sum 1 / k_e, each of the at most n - 1 splits at most
+1 + slack <= 5/2, and peeling at most rho per vertex, so the sample has at most 5.5 rho n = O(n log n / eps^2)
+edges in expectation. Dense graphs shrink accordingly: the complete graph on 2000 vertices keeps 1 / 3.5 of
+its pairs at eps = 0.5 and 1 / 14 at eps = 1 (min cut 12% and 23% low, inside the bound), while graphs
+with degrees near rho keep nearly everything.
+
+Each certification is a few linear rounds (about log n / slack on dense pieces, O(m / eps) with Matula's
+cap); on the complete graph the whole stage takes about half as long as one exact Hao-Orlin run. A pair's
+copies share its piece and so its bound, which lets them be drawn as one binomial count.
+*/
+
+#include "karger.hpp"
+#include "max_adjacency.hpp"
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+using Weight = std::uint64_t;
+
+// a vertex-induced piece of the graph as indices into the collapsed pairs, and a lower bound on the
+// strength of each of them
+struct Piece {
+    std::vector<std::size_t> pairs;
+    Weight floor;
+};
+
+// the smallest supernode cut seen and a lower bound on lambda, for a connected graph
+struct Certificate {
+    Weight lower = std::numeric_limits<Weight>::max();
+    Weight cut = std::numeric_limits<Weight>::max();
+    std::vector<char> side; // per vertex
+};
+
+// stops early (lower = 0) once a cut of at most floor shows up, since the piece's bound cannot beat that
+template <class Index>
+Certificate certify(Index n, std::vector<detail::WeightedPair<Index, Weight>> pairs, Weight floor) {
+    Certificate out;
+    std::vector<Index> group(n), label;
+    std::iota(group.begin(), group.end(), Index{0});
+    std::vector<Weight> degree;
+    double slack = 0.125;
+    for (Index vertices = n; vertices > 1;) {
+        degree.assign(vertices, 0);
+        for (const auto& [a, b, w] : pairs) {
+            degree[a] += w;
+            degree[b] += w;
+        }
+        auto smallest = std::min_element(degree.begin(), degree.end());
+        if (*smallest < out.cut) {
+            out.cut = *smallest;
+            Index s = static_cast<Index>(smallest - degree.begin());
+            out.side.assign(n, 0);
+            for (Index v = 0; v < n; ++v) out.side[v] = group[v] == s;
+        }
+        if (out.cut <= floor) {
+            out.lower = 0;
+            return out;
+        }
+
+        Weight k = static_cast<Weight>(std::ceil(static_cast<double>(out.cut) / (1.0 + slack)));
+        out.lower = std::min(out.lower, k);
+        Index next = detail::contractConnectedPairs(vertices, pairs, k, label);
+        for (Index v = 0; v < n; ++v) group[v] = label[group[v]];
+        if (8 * static_cast<std::int64_t>(vertices - next) < vertices) slack = std::min(1.5, 2.0 * slack);
+        vertices = next;
+    }
+    return out;
+}
+
+template <class Index>
+BasicSparsifiedGraph<Index> sparsify(Index n, std::span<const BasicEdge<Index>> edges, double eps, std::uint64_t seed) {
+    if (!(eps > 0.0 && eps <= 1.0)) throw std::invalid_argument("sparsifyCuts needs 0 < eps <= 1");
+    BasicSparsifiedGraph<Index> out;
+    out.n = n;
+    if (n <= 1) return out;
+
+    auto pairs = detail::collapseParallelEdges<Weight>(edges);
+    double rho = 15.0 * std::log(static_cast<double>(n)) / (eps * eps);
+    std::vector<Weight> strength(pairs.size(), 1);
+
+    std::vector<Piece> stack(1);
+    stack[0].pairs.resize(pairs.size());
+    std::iota(stack[0].pairs.begin(), stack[0].pairs.end(), std::size_t{0});
+    stack[0].floor = 1;
+    std::vector<Index> local(n, -1), vertices;
+    while (!stack.empty()) {
+        Piece piece = std::move(stack.back());
+        stack.pop_back();
+        for (Index v : vertices) local[v] = -1;
+        vertices.clear();
+        for (std::size_t i : piece.pairs) {
+            for (Index x : {pairs[i].a, pairs[i].b}) {
+                if (local[x] == -1) {
+                    local[x] = static_cast<Index>(vertices.size());
+                    vertices.push_back(x);
+                }
+            }
+        }
+        Index size = static_cast<Index>(vertices.size());
+
+        // peel vertices of degree <= rho
+        std::vector<Weight> degree(size, 0);
+        std::vector<std::vector<std::size_t>> adj(size); // positions in piece.pairs
+        for (std::size_t j = 0; j < piece.pairs.size(); ++j) {
+            const auto& p = pairs[piece.pairs[j]];
+            degree[local[p.a]] += p.weight;
+            degree[local[p.b]] += p.weight;
+            adj[local[p.a]].push_back(j);
+            adj[local[p.b]].push_back(j);
+        }
+        auto light = [&](Index v) { return static_cast<double>(degree[v]) <= rho; };
+        std::vector<char> alive(piece.pairs.size(), 1), peeled(size, 0);
+        std::vector<Index> queue;
+        for (Index v = 0; v < size; ++v) {
+            if (light(v)) queue.push_back(v);
+        }
+        bool shrunk = !queue.empty();
+        while (!queue.empty()) {
+            Index v = queue.back();
+            queue.pop_back();
+            if (peeled[v]) continue;
+            peeled[v] = 1;
+            for (std::size_t j : adj[v]) {
+                if (!alive[j]) continue;
+                alive[j] = 0;
+                const auto& p = pairs[piece.pairs[j]];
+                strength[piece.pairs[j]] = piece.floor;
+                Index y = local[p.a] == v ? local[p.b] : local[p.a];
+                bool wasLight = light(y);
+                degree[y] -= p.weight;
+                if (!wasLight && light(y)) queue.push_back(y);
+            }
+        }
+
+        // what is left, one piece per component
+        UnionFind<Index> uf(size);
+        for (std::size_t j = 0; j < piece.pairs.size(); ++j) {
+            const auto& p = pairs[piece.pairs[j]];
+            if (alive[j]) uf.unite(local[p.a], local[p.b]);
+        }
+        Index components = 0;
+        for (Index v = 0; v < size; ++v) components += !peeled[v] && uf.find(v) == v;
+        if (shrunk || components > 1) {
+            std::vector<Index> child(size, -1);
+            std::size_t first = stack.size();
+            for (std::size_t j = 0; j < piece.pairs.size(); ++j) {
+                if (!alive[j]) continue;
+                Index r = uf.find(local[pairs[piece.pairs[j]].a]);
+                if (child[r] == -1) {
+                    child[r] = static_cast<Index>(stack.size() - first);
+                    stack.push_back({{}, piece.floor});
+                }
+                stack[first + child[r]].pairs.push_back(piece.pairs[j]);
+            }
+            continue;
+        }
+
+        Weight total = 0;
+        for (std::size_t i : piece.pairs) total += pairs[i].weight;
+        auto settled = [&](Weight floor) {
+            if (static_cast<double>(total) > 2.0 * static_cast<double>(floor) * static_cast<double>(size - 1)) return false;
+            for (std::size_t i : piece.pairs) strength[i] = floor;
+            return true;
+        };
+        if (settled(piece.floor)) continue;
+
+        std::vector<detail::WeightedPair<Index, Weight>> within;
+        within.reserve(piece.pairs.size());
+        for (std::size_t i : piece.pairs) within.push_back({local[pairs[i].a], local[pairs[i].b], pairs[i].weight});
+        Certificate certificate = certify(size, std::move(within), piece.floor);
+        Weight floor = std::max(piece.floor, certificate.lower);
+        if (settled(floor)) continue;
+
+        // split along the smallest cut seen
+        Piece inside{{}, floor}, outside{{}, floor};
+        for (std::size_t i : piece.pairs) {
+            char a = certificate.side[local[pairs[i].a]], b = certificate.side[local[pairs[i].b]];
+            if (a != b) strength[i] = floor;
+            else (a ? inside : outside).pairs.push_back(i);
+        }
+        if (!inside.pairs.empty()) stack.push_back(std::move(inside));
+        if (!outside.pairs.empty()) stack.push_back(std::move(outside));
+    }
+
+    std::mt19937_64 rng(seed);
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        double p = std::min(1.0, rho / static_cast<double>(strength[i]));
+        std::uint64_t kept = p >= 1.0 ? pairs[i].weight : std::binomial_distribution<std::uint64_t>(pairs[i].weight, p)(rng);
+        if (kept == 0) continue;
+        out.edges.push_back({pairs[i].a, pairs[i].b});
+        out.weights.push_back(static_cast<double>(kept) / p);
+    }
+    return out;
+}
+
+}
+
+SparsifiedGraph sparsifyCuts(int n, std::span<const Edge> edges, double eps, std::uint64_t seed) {
+    return sparsify(n, detail::intEdges(edges), eps, seed);
+}
+
+SparsifiedGraph64 sparsifyCuts(std::int64_t n, std::span<const Edge64> edges, double eps, std::uint64_t seed) {
+    return sparsify(n, edges, eps, seed);
+}
+
+double minCutSparsified(int n, std::span<const Edge> edges, double eps, std::uint64_t seed) {
+    SparsifiedGraph sparse = sparsify(n, detail::intEdges(edges), eps, seed);
+    return minCutHaoOrlin(sparse.n, sparse.edges, sparse.weights);
+}
+
+double minCutSparsified(std::int64_t n, std::span<const Edge64> edges, double eps, std::uint64_t seed) {
+    SparsifiedGraph64 sparse = sparsify(n, edges, eps, seed);
+    return minCutHaoOrlin(sparse.n, sparse.edges, sparse.weights);
+}
+
+}
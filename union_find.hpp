@@ -0,0 +1,296 @@
+#ifndef KARGER_UNION_FIND_HPP
+#define KARGER_UNION_FIND_HPP
+
+/* Union-find
+UnionFind<Index, Compression, Linking> is the disjoint set behind the contraction engines, with the
+path compression and linking rules chosen at compile time:
+
+- Compression: PathHalving (every other node on the path skips to its grandparent), PathSplitting
+  (every node skips to its grandparent) or FullCompression (two passes, every node points at the root).
+- Linking: LinkByRank (8-bit ranks, a rank never exceeds log2 n), LinkBySize (sizes in Index) or
+  LinkByRandomPriority (the root with the larger hashed id wins, which keeps trees O(log n) deep in
+  expectation without storing anything).
+
+A root is its own parent. The rank or size lives in a separate array of the narrowest type that holds it,
+stored as size - 1 so every linking rule starts from zero. Keeping the rank in the parent slot (negative
+roots) saves that array but costs a sign test on every step of every find, which measured slower.
+
+Every union records the root it demoted, so reset() puts the structure back to n singletons in time
+proportional to the unions since the last reset rather than to n. Repeated trials that only contract
+part of the graph pay for what they touched.
+bench/union_find_bench.cpp compares the combinations on the bench graph families.
+
+RollbackUnionFind<Index> links by rank and never compresses, so every union can be undone: checkpoint()
+marks the current state and rollback(mark) undoes the unions since then, newest first. find() costs
+O(log n) instead of nearly O(1), which is the price of branches sharing one structure (Karger-Stein).
+
+ConcurrentUnionFind<Index> lets any number of threads call find, same and unite at once without locks
+(Jayanti-Tarjan randomised linking by index). Parents are atomics. find halves the path with a CAS that
+may fail harmlessly, and unite CASes the root with the lower hashed priority under the other one,
+retrying from find when another thread linked it first. A parent always has a higher priority than
+its child, so no interleaving can form a cycle and trees stay O(log n) deep in expectation. Exactly one
+unite call returns true for each merge, so summing the true results across threads counts the unions.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace karger {
+
+struct PathHalving {
+    template <class Index>
+    static Index find(Index* parent, Index x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+};
+
+struct PathSplitting {
+    template <class Index>
+    static Index find(Index* parent, Index x) {
+        while (parent[x] != x) {
+            Index next = parent[x];
+            parent[x] = parent[next];
+            x = next;
+        }
+        return x;
+    }
+};
+
+struct FullCompression {
+    template <class Index>
+    static Index find(Index* parent, Index x) {
+        Index root = x;
+        while (parent[root] != root) root = parent[root];
+        while (x != root) {
+            Index next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+};
+
+// link(weight, a, b) picks which of two distinct roots stays a root, returns it and updates its weight
+struct LinkByRank {
+    template <class Index>
+    using Weight = std::uint8_t;
+
+    template <class Index>
+    static Index link(Weight<Index>* rank, Index a, Index b) {
+        if (rank[a] < rank[b] || (rank[a] == rank[b] && a > b)) std::swap(a, b);
+        if (rank[a] == rank[b]) ++rank[a];
+        return a;
+    }
+};
+
+struct LinkBySize {
+    template <class Index>
+    using Weight = Index; // size - 1
+
+    template <class Index>
+    static Index link(Weight<Index>* size, Index a, Index b) {
+        if (size[a] < size[b] || (size[a] == size[b] && a > b)) std::swap(a, b);
+        size[a] += size[b] + 1;
+        return a;
+    }
+};
+
+struct LinkByRandomPriority {
+    struct Weight {}; // nothing stored
+
+    template <class Index>
+    static Index link(Weight*, Index a, Index b) {
+        return priority(a) < priority(b) ? b : a;
+    }
+
+    static std::uint64_t priority(std::uint64_t x) {
+        x *= 0x9e3779b97f4a7c15ull;
+        return x ^ (x >> 29);
+    }
+};
+
+namespace detail {
+
+template <class Linking, class Index, class = void>
+struct LinkWeight {
+    using type = typename Linking::Weight;
+    static constexpr bool stored = false;
+};
+
+template <class Linking, class Index>
+struct LinkWeight<Linking, Index, std::void_t<typename Linking::template Weight<Index>>> {
+    using type = typename Linking::template Weight<Index>;
+    static constexpr bool stored = true;
+};
+
+}
+
+template <class Index = int, class Compression = PathHalving, class Linking = LinkByRank>
+class UnionFind {
+    using Weight = typename detail::LinkWeight<Linking, Index>::type;
+    static constexpr bool kStored = detail::LinkWeight<Linking, Index>::stored;
+
+public:
+    explicit UnionFind(Index n = 0) { assign(n); }
+
+    Index size() const { return static_cast<Index>(parent_.size()); }
+    Index components() const { return size() - static_cast<Index>(unions_); }
+
+    Index find(Index x) { return Compression::find(parent_.data(), x); }
+
+    bool same(Index a, Index b) { return find(a) == find(b); }
+
+    // false when a and b were already in one set
+    bool unite(Index a, Index b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        Index root = Linking::link(weight_.data(), a, b);
+        Index demoted = a ^ b ^ root;
+        parent_[demoted] = root;
+        linked_[unions_++] = demoted; // at most n - 1 of them
+        return true;
+    }
+
+    // back to singletons in O(unions since the last reset). Every weight that moved off zero belongs to a
+    // demoted root or to a surviving root, and each surviving root is the parent of at least one demoted
+    // node, so clearing both ends of every recorded link catches them all in any order.
+    void reset() {
+        for (std::size_t i = 0; i < unions_; ++i) {
+            Index x = linked_[i];
+            if constexpr (kStored) {
+                weight_[parent_[x]] = 0;
+                weight_[x] = 0;
+            }
+            parent_[x] = x;
+        }
+        unions_ = 0;
+    }
+
+    // back to n singletons of a possibly different size, O(n)
+    void assign(Index n) {
+        parent_.resize(n);
+        for (Index i = 0; i < n; ++i) parent_[i] = i;
+        if constexpr (kStored) weight_.assign(n, 0);
+        linked_.resize(n);
+        unions_ = 0;
+    }
+
+private:
+    std::vector<Index> parent_;
+    std::vector<Weight> weight_; // empty when the linking rule stores nothing
+    std::vector<Index> linked_; // demoted roots in union order
+    std::size_t unions_ = 0; // not Index, so stores through parent_ cannot alias it
+};
+
+template <class Index = int>
+class RollbackUnionFind {
+public:
+    explicit RollbackUnionFind(Index n = 0) : parent_(n), rank_(n, 0) {
+        for (Index i = 0; i < n; ++i) parent_[i] = i;
+        history_.reserve(n);
+    }
+
+    Index size() const { return static_cast<Index>(parent_.size()); }
+    Index components() const { return size() - static_cast<Index>(history_.size()); }
+
+    Index find(Index x) const {
+        while (parent_[x] != x) x = parent_[x];
+        return x;
+    }
+
+    bool same(Index a, Index b) const { return find(a) == find(b); }
+
+    // false when a and b were already in one set
+    bool unite(Index a, Index b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (rank_[a] < rank_[b] || (rank_[a] == rank_[b] && a > b)) std::swap(a, b);
+        bool bumped = rank_[a] == rank_[b];
+        if (bumped) ++rank_[a];
+        parent_[b] = a;
+        history_.push_back({b, bumped});
+        return true;
+    }
+
+    std::size_t checkpoint() const { return history_.size(); }
+
+    // undo every union made since checkpoint() returned mark
+    void rollback(std::size_t mark) {
+        while (history_.size() > mark) {
+            auto [b, bumped] = history_.back();
+            history_.pop_back();
+            if (bumped) --rank_[parent_[b]];
+            parent_[b] = b;
+        }
+    }
+
+private:
+    struct Link {
+        Index demoted;
+        bool bumped; // the surviving root's rank went up
+    };
+
+    std::vector<Index> parent_;
+    std::vector<std::uint8_t> rank_;
+    std::vector<Link> history_;
+};
+
+template <class Index = int>
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(Index n = 0) : parent_(static_cast<std::size_t>(n)) {
+        for (Index i = 0; i < n; ++i) parent_[i].store(i, std::memory_order_relaxed);
+    }
+
+    Index size() const { return static_cast<Index>(parent_.size()); }
+
+    // the root of x at some moment during the call
+    Index find(Index x) {
+        for (;;) {
+            Index p = parent_[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            Index g = parent_[p].load(std::memory_order_relaxed);
+            if (g == p) return p;
+            parent_[x].compare_exchange_weak(p, g, std::memory_order_relaxed); // halving, losing the race is fine
+            x = g;
+        }
+    }
+
+    // exact when nothing unites a and b concurrently
+    bool same(Index a, Index b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return true;
+            if (parent_[a].load(std::memory_order_relaxed) == a) return false; // a was still a root after b's find
+        }
+    }
+
+    // false when a and b were already in one set
+    bool unite(Index a, Index b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (LinkByRandomPriority::priority(a) > LinkByRandomPriority::priority(b)) std::swap(a, b);
+            Index expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return true;
+        }
+    }
+
+private:
+    std::vector<std::atomic<Index>> parent_;
+};
+
+}
+
+#endif
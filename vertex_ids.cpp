@@ -0,0 +1,201 @@
+/* Sparse vertex id remapping
+Turns edges over arbitrary 64-bit ids into edges over 0..n-1, the only form the engines accept, and keeps
+the table needed to translate results back.
+
+The edges are split into one contiguous run per thread and each run is deduplicated into its own growing
+hash set, so the sets stay about as small as the number of distinct ids rather than the number of
+endpoints. The union of the sets is sorted (one run per thread, merged pairwise) and deduplicated, which
+gives every id its dense id as its rank; numbering by rank makes the result independent of the thread
+count. The final linear-probing table, sized to twice the distinct ids, is filled in parallel with a
+compare-and-swap per slot and then used to translate the edges. UINT64_MAX marks a free slot, so that
+single id is tracked beside the tables instead of inside them.
+*/
+
+#include "karger.hpp"
+#include "parallel.hpp"
+#include <atomic>
+#include <climits>
+#include <stdexcept>
+
+namespace karger {
+
+namespace {
+
+constexpr std::uint64_t kEmptySlot = UINT64_MAX;
+constexpr std::size_t kBlock = std::size_t{1} << 16; // items per parallel task
+
+std::uint64_t homeSlot(std::uint64_t id, std::uint64_t mask) {
+    return detail::mix64(id) & mask;
+}
+
+std::size_t blocksFor(std::size_t count) {
+    return (count + kBlock - 1) / kBlock;
+}
+
+std::size_t tableSize(std::size_t items) {
+    std::size_t capacity = 16;
+    while (capacity < 2 * items) capacity *= 2;
+    return capacity;
+}
+
+// single-threaded open-addressing set that doubles at half load
+class IdSet {
+public:
+    IdSet() : keys_(16, kEmptySlot), mask_(15) {}
+
+    void insert(std::uint64_t id) {
+        if (id == kEmptySlot) {
+            hasEmptyKey_ = true;
+            return;
+        }
+        std::uint64_t s = homeSlot(id, mask_);
+        while (keys_[s] != kEmptySlot) {
+            if (keys_[s] == id) return;
+            s = (s + 1) & mask_;
+        }
+        keys_[s] = id;
+        if (2 * ++size_ > keys_.size()) grow();
+    }
+
+    std::size_t size() const { return size_; }
+    bool hasEmptyKey() const { return hasEmptyKey_; }
+
+    template <class F>
+    void forEach(F&& f) const {
+        for (std::uint64_t key : keys_) {
+            if (key != kEmptySlot) f(key);
+        }
+    }
+
+private:
+    void grow() {
+        std::vector<std::uint64_t> old(2 * keys_.size(), kEmptySlot);
+        old.swap(keys_);
+        mask_ = keys_.size() - 1;
+        for (std::uint64_t key : old) {
+            if (key == kEmptySlot) continue;
+            std::uint64_t s = homeSlot(key, mask_);
+            while (keys_[s] != kEmptySlot) s = (s + 1) & mask_;
+            keys_[s] = key;
+        }
+    }
+
+    std::vector<std::uint64_t> keys_;
+    std::uint64_t mask_;
+    std::size_t size_ = 0;
+    bool hasEmptyKey_ = false;
+};
+
+// sorts `ids` with one run per thread, then merges neighbouring runs until one is left
+void parallelSort(std::vector<std::uint64_t>& ids, int threads) {
+    std::size_t runs = std::min<std::size_t>(detail::resolveThreads(threads), blocksFor(ids.size()));
+    if (runs <= 1) {
+        std::sort(ids.begin(), ids.end());
+        return;
+    }
+    std::vector<std::size_t> bound(runs + 1);
+    for (std::size_t k = 0; k <= runs; ++k) bound[k] = ids.size() * k / runs;
+    detail::parallelFor(runs, threads, [&](std::size_t k) {
+        std::sort(ids.begin() + bound[k], ids.begin() + bound[k + 1]);
+    });
+    for (std::size_t width = 1; width < runs; width *= 2) {
+        detail::parallelFor((runs + 2 * width - 1) / (2 * width), threads, [&](std::size_t pair) {
+            std::size_t first = pair * 2 * width;
+            std::size_t middle = std::min(first + width, runs), last = std::min(first + 2 * width, runs);
+            std::inplace_merge(ids.begin() + bound[first], ids.begin() + bound[middle], ids.begin() + bound[last]);
+        });
+    }
+}
+
+}
+
+int VertexIdMap::dense(std::uint64_t id) const {
+    if (id == kEmptySlot) return emptyKeyValue_;
+    if (slots_.empty()) return -1;
+    for (std::uint64_t s = homeSlot(id, mask_);; s = (s + 1) & mask_) {
+        if (slots_[s].key == id) return slots_[s].value;
+        if (slots_[s].key == kEmptySlot) return -1;
+    }
+}
+
+std::vector<std::uint64_t> VertexIdMap::externalSide(std::span<const std::uint8_t> side, std::uint8_t which) const {
+    std::vector<std::uint64_t> out;
+    for (std::size_t v = 0; v < side.size(); ++v) {
+        if (side[v] == which) out.push_back(ids_[v]);
+    }
+    return out;
+}
+
+std::vector<ExternalEdge> VertexIdMap::externalEdges(std::span<const Edge> edges) const {
+    std::vector<ExternalEdge> out;
+    out.reserve(edges.size());
+    for (const auto& e : edges) out.push_back(external(e));
+    return out;
+}
+
+RemappedGraph remapVertexIds(std::span<const ExternalEdge> edges, int threads) {
+    RemappedGraph out;
+    VertexIdMap& map = out.ids;
+    const std::size_t m = edges.size();
+    if (m == 0) return out;
+
+    // distinct ids per run
+    std::size_t runs = std::min<std::size_t>(detail::resolveThreads(threads), blocksFor(m));
+    std::vector<IdSet> seen(runs);
+    detail::parallelFor(runs, threads, [&](std::size_t k) {
+        for (std::size_t i = m * k / runs, end = m * (k + 1) / runs; i < end; ++i) {
+            seen[k].insert(edges[i].u);
+            seen[k].insert(edges[i].v);
+        }
+    });
+
+    bool hasEmptyKey = false;
+    std::size_t total = 0;
+    for (const auto& set : seen) {
+        hasEmptyKey = hasEmptyKey || set.hasEmptyKey();
+        total += set.size();
+    }
+    map.ids_.reserve(total + 1);
+    for (auto& set : seen) {
+        set.forEach([&](std::uint64_t id) { map.ids_.push_back(id); });
+        set = IdSet();
+    }
+    parallelSort(map.ids_, threads);
+    map.ids_.erase(std::unique(map.ids_.begin(), map.ids_.end()), map.ids_.end());
+    const std::size_t hashed = map.ids_.size();
+    if (hasEmptyKey) {
+        map.emptyKeyValue_ = static_cast<int>(hashed); // the largest id sorts last
+        map.ids_.push_back(kEmptySlot);
+    }
+    if (map.ids_.size() > static_cast<std::size_t>(INT_MAX)) {
+        throw std::length_error("remapVertexIds: more than INT_MAX distinct vertex ids");
+    }
+
+    // dense id = rank in sorted order; every key is distinct so a claimed slot is never shared
+    std::size_t capacity = tableSize(hashed);
+    map.slots_.assign(capacity, {kEmptySlot, -1});
+    map.mask_ = capacity - 1;
+    detail::parallelFor(blocksFor(hashed), threads, [&](std::size_t b) {
+        for (std::size_t r = b * kBlock, end = std::min(hashed, r + kBlock); r < end; ++r) {
+            std::uint64_t id = map.ids_[r];
+            for (std::uint64_t s = homeSlot(id, map.mask_);; s = (s + 1) & map.mask_) {
+                std::uint64_t expected = kEmptySlot;
+                if (std::atomic_ref<std::uint64_t>(map.slots_[s].key).compare_exchange_strong(expected, id, std::memory_order_relaxed)) {
+                    map.slots_[s].value = static_cast<int>(r);
+                    break;
+                }
+            }
+        }
+    });
+
+    out.n = map.n();
+    out.edges.resize(m);
+    detail::parallelFor(blocksFor(m), threads, [&](std::size_t b) {
+        for (std::size_t i = b * kBlock, end = std::min(m, i + kBlock); i < end; ++i) {
+            out.edges[i] = {map.dense(edges[i].u), map.dense(edges[i].v)};
+        }
+    });
+    return out;
+}
+
+}